@@ -54,6 +54,24 @@ namespace algs {
  * A concrete patch strategy object is derived from the base class to
  * provide those routines for a specific problem.
  *
+ * Instead of the SSP form, one of the low-storage (2N) Runge-Kutta
+ * schemes of Williamson (J. Comput. Phys., Vol. 35, pp. 48-56, 1980) may
+ * be selected with rk_scheme.  Each stage of such a scheme updates a
+ * stage increment dU and the solution U in one pass over each patch,
+ *
+ *    dU = A_i * dU + dt * F(U),   U = U + B_i * dU,
+ *
+ * through MethodOfLinesPatchStrategy::lowStorageStep().  The increment
+ * is kept in the current context, whose solution values are not needed
+ * once they are copied to scratch, so a scheme of any number of stages
+ * needs no storage beyond that of the three-stage SSP scheme, and each
+ * stage reads and writes each solution array once.  The ghost cells of
+ * each stage are filled at the stage time, time + C_i * dt, where C_i
+ * follows from A and B.  Built-in schemes are Williamson's third-order
+ * scheme and the five-stage fourth-order scheme of Carpenter and Kennedy
+ * (NASA TM-109112, 1994); other schemes may be given by their A and B
+ * coefficients.
+ *
  * This class is derived from the mesh::StandardTagAndInitStrategy abstract
  * base class which defines an interface for routines required by the
  * dynamic adaptive mesh refinement routines in the mesh::GriddingAlgorithm
@@ -74,6 +92,18 @@ namespace algs {
  *       used in the multi-step Strong Stability Preserving (SSP) Runge-Kutta
  *       algorithm.
  *
+ *    - \b    rk_scheme <br>
+ *       "SSP" for the scheme given by alpha_1, alpha_2 and beta,
+ *       "LOW_STORAGE_RK3" or "LOW_STORAGE_RK4" for the built-in
+ *       low-storage schemes, or "LOW_STORAGE" for the low-storage scheme
+ *       given by low_storage_a and low_storage_b.
+ *
+ *    - \b    low_storage_a
+ *    - \b    low_storage_b <br>
+ *       arrays of double values (length = number of stages) specifying
+ *       the coefficients A_i and B_i of a "LOW_STORAGE" scheme.  A_1 must
+ *       be 0.
+ *
  * Note that when continuing from restart, the input parameters in the input
  * database override all values read in from the restart database.
  *
@@ -111,6 +141,30 @@ namespace algs {
  *      <td>opt</td>
  *      <td>Parameter read from restart db may be overridden by input db</td>
  *   </tr>
+ *   <tr>
+ *      <td>rk_scheme</td>
+ *      <td>string</td>
+ *      <td>"SSP"</td>
+ *      <td>"SSP", "LOW_STORAGE_RK3", "LOW_STORAGE_RK4", "LOW_STORAGE"</td>
+ *      <td>opt</td>
+ *      <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
+ *   <tr>
+ *      <td>low_storage_a</td>
+ *      <td>array of doubles</td>
+ *      <td>none</td>
+ *      <td>first value 0.0</td>
+ *      <td>req if rk_scheme is "LOW_STORAGE"</td>
+ *      <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
+ *   <tr>
+ *      <td>low_storage_b</td>
+ *      <td>array of doubles</td>
+ *      <td>none</td>
+ *      <td>same number as low_storage_a</td>
+ *      <td>req if rk_scheme is "LOW_STORAGE"</td>
+ *      <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
  * </table>
  *
  * The following represents a sample input entry:
@@ -123,6 +177,14 @@ namespace algs {
  *  }
  *  @endcode
  *
+ * or, for the fourth-order low-storage scheme:
+ *
+ * @code
+ *  MethodOfLinesIntegrator{
+ *     rk_scheme             = "LOW_STORAGE_RK4"
+ *  }
+ *  @endcode
+ *
  * @see mesh::StandardTagAndInitStrategy
  */
 
@@ -350,6 +412,24 @@ private:
     */
    static const int ALGS_METHOD_OF_LINES_INTEGRATOR_VERSION;
 
+   /*
+    * Advance the hierarchy by the low-storage scheme, with the solution
+    * already copied to scratch.
+    */
+   void
+   advanceHierarchyLowStorage(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const double time,
+      const double dt);
+
+   /*
+    * Set the low-storage coefficients of the built-in scheme named by
+    * d_rk_scheme, and compute the stage times of the current
+    * coefficients.
+    */
+   void
+   setLowStorageCoefficients();
+
    /*
     * Copy all solution data from current context to scratch context.
     */
@@ -408,6 +488,15 @@ private:
    std::vector<double> d_alpha_2;
    std::vector<double> d_beta;
 
+   /*
+    * Runge-Kutta scheme, and the coefficients and stage times of the
+    * low-storage schemes.
+    */
+   std::string d_rk_scheme;
+   std::vector<double> d_low_storage_a;
+   std::vector<double> d_low_storage_b;
+   std::vector<double> d_low_storage_c;
+
    /*
     * A pointer to the method of lines patch model that will perform
     * the patch-based numerical operations.
@@ -107,6 +107,37 @@ public:
       const double alpha_2,
       const double beta) const = 0;
 
+   /*!
+    * Advance a single stage of a low-storage (2N) Runge-Kutta scheme.
+    * With U the solution in the interior-with-ghosts context, whose
+    * ghosts have been filled, and dU the stage increment held in the
+    * interior context, the stage is
+    *
+    *    dU = a * dU + dt * F(U)
+    *    U  = U + b * dU
+    *
+    * Both updates should be made in one pass over the patch after F(U)
+    * is evaluated.  The first stage has a = 0, and then dU must be
+    * overwritten without being read, since the interior context still
+    * holds the solution from the start of the step.  The interior
+    * context holds the solution again when the step completes.
+    *
+    * The default implementation is an unrecoverable error; this
+    * function must be overridden to use the low-storage schemes of
+    * MethodOfLinesIntegrator.
+    *
+    * @param patch patch that the RK stage is being applied to
+    * @param dt    timestep
+    * @param a     coefficient of the previous stage increment
+    * @param b     coefficient of the solution update
+    */
+   virtual void
+   lowStorageStep(
+      hier::Patch& patch,
+      const double dt,
+      const double a,
+      const double b) const;
+
    /*!
     * Using a user-specified gradient detection scheme, determine cells which
     * have high gradients and, consequently, should be refined.
@@ -113,6 +113,30 @@ namespace algs {
  *       representing the number of cells by which tagged cells are buffered
  *       before clustering into boxes.
  *
+ *    - \b    cost_model
+ *       "NONE", "ADVISORY" or "AUTO".  With "ADVISORY" the integrator
+ *       measures the wall clock time spent advancing each level, the
+ *       number of cells on each level, and the stable time increment of
+ *       each level.  Every cost_model_interval coarse steps it predicts
+ *       the wall clock time per unit of simulated time for refined and
+ *       for synchronized timestepping and reports the predictions and
+ *       the preferred mode to the log file.  The timestepping mode is
+ *       fixed by the level integrator when it is constructed, so a
+ *       change of mode takes effect on the next run.  "AUTO" also tunes
+ *       the regrid interval when synchronized timestepping is used: it
+ *       moves the interval, and with it the tag buffer, by one after
+ *       each report in the direction that lowered the measured wall
+ *       clock time per unit of simulated time.  The tag_buffer values
+ *       are upper bounds for this search.
+ *
+ *    - \b    cost_model_interval
+ *       minimum number of coarse steps between cost model reports.
+ *
+ *    - \b    cost_model_threshold
+ *       fraction by which the predicted cost of the other timestepping
+ *       mode must be lower than that of the current mode for the cost
+ *       model to prefer it.
+ *
  * Note that the input values for regrid_interval, end_time, grow_dt,
  * max_integrator_steps, and tag_buffer override values read in from restart.
  *
@@ -174,6 +198,30 @@ namespace algs {
  *     <td>opt</td>
  *     <td>Parameter read from restart db may be overridden by input db</td>
  *   </tr>
+ *   <tr>
+ *     <td>cost_model</td>
+ *     <td>string</td>
+ *     <td>"NONE"</td>
+ *     <td>"NONE", "ADVISORY", "AUTO"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>cost_model_interval</td>
+ *     <td>int</td>
+ *     <td>10</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>cost_model_threshold</td>
+ *     <td>double</td>
+ *     <td>0.1</td>
+ *     <td>[0, 1)</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
  * </table>
  *
  * A sample input file entry might look like:
@@ -226,7 +274,10 @@ public:
    /*!
     * Set AMR patch hierarchy configuration and data at start of simulation.
     * If the run is begun from a restart file, the hierarchy and data
-    * are read from the hierarchy database.  Otherwise, the hierarchy
+    * are read from the hierarchy database.  If the restart was written
+    * by a different number of processes, the levels read are then
+    * repartitioned by the gridding algorithm, regridding the levels
+    * finer than level 0.  Otherwise, the hierarchy
     * and data are initialized by the gridding algorithm data member.
     * In this case, the coarsest level is constructed and initialized.
     * Then, error estimation is performed to determine if and where it
@@ -245,6 +296,25 @@ public:
    double
    initializeHierarchy();
 
+   /**
+    * Roll the simulation back to the state in the root restart database,
+    * such as a checkpoint opened by
+    * tbox::RestartManager::openMemoryCheckpoint().  The integration time,
+    * step count and time increments are read from the restart database,
+    * the hierarchy levels and data are replaced by those read (see
+    * hier::PatchHierarchy::resetFromRestart()), and the hierarchy
+    * configuration is reset in the tagging strategy.  Parameters read
+    * from input, such as the end time, are kept.  The double return value
+    * is the time increment for the next advance of level 0, as from
+    * initializeHierarchy().
+    *
+    * The level integrator and other objects must hold no state at the
+    * time of the restart data other than the patch data; objects that do
+    * must reset it from the root database themselves.
+    */
+   double
+   resetFromRestart();
+
    /**
     * Advance each level in the hierarchy through the given time increment
     * and return an appropriate time increment for subsequent advances of the
@@ -553,6 +623,48 @@ public:
    putToRestart(
       const std::shared_ptr<tbox::Database>& restart_db) const;
 
+   /**
+    * Return true if the most recent cost model report predicted that
+    * refined timestepping is cheaper than synchronized timestepping.
+    * Before the first report the current mode is returned.
+    */
+   bool
+   costModelPrefersRefinedTimestepping() const
+   {
+      return d_cost_prefers_refined;
+   }
+
+   /**
+    * Return the number of cost model reports made so far.
+    */
+   int
+   getNumberOfCostModelReports() const
+   {
+      return d_cost_number_reports;
+   }
+
+   /**
+    * Return the advance time per unit simulated time that the most
+    * recent cost model report predicted for refined timestepping, or
+    * zero before the first report.
+    */
+   double
+   getCostModelRefinedPrediction() const
+   {
+      return d_cost_refined_prediction;
+   }
+
+   /**
+    * Return the advance time per unit simulated time that the most
+    * recent cost model report predicted for synchronized timestepping,
+    * or zero before the first report.
+    */
+   double
+   getCostModelSynchronizedPrediction() const
+   {
+      return d_cost_sync_prediction;
+   }
+
    /**
     * Returns the object name.
     */
@@ -624,6 +736,25 @@ private:
    coarserLevelRegridsToo(
       const int level_number) const;
 
+   /*
+    * Record the wall clock time and stable time increment of one
+    * advance of the given level for the cost model.
+    */
+   void
+   recordLevelAdvanceCost(
+      const int level_number,
+      const double advance_time,
+      const double dt_stable);
+
+   /*
+    * Close the current cost model window: predict the cost of refined
+    * and synchronized timestepping from the measured level costs,
+    * report the predictions and, in "AUTO" mode, adjust the regrid
+    * interval.
+    */
+   void
+   evaluateCostModel();
+
    /*
     * Read input data from specified input database and initialize class
     * members.  The argument is_from_restart should be set to true if the
@@ -741,6 +872,32 @@ private:
 
    bool d_barrier_and_time;
 
+   /*
+    * Cost model parameters and the measurements of the current window:
+    * wall clock time spent advancing each level, cells advanced on each
+    * level, and the last stable time increment returned for each level.
+    * d_cost_max_tag_buffer holds the tag buffers the hierarchy's
+    * Connector widths were computed with, which bound the regrid
+    * interval search.
+    */
+   std::string d_cost_model;
+   int d_cost_model_interval;
+   double d_cost_model_threshold;
+   std::vector<double> d_cost_level_time;
+   std::vector<double> d_cost_level_cells;
+   std::vector<double> d_cost_level_dt;
+   std::vector<int> d_cost_max_tag_buffer;
+   double d_cost_regrid_time;
+   double d_cost_window_wall_start;
+   double d_cost_window_sim_start;
+   int d_cost_window_steps;
+   double d_cost_last_rate;
+   int d_cost_regrid_direction;
+   bool d_cost_prefers_refined;
+   int d_cost_number_reports;
+   double d_cost_refined_prediction;
+   double d_cost_sync_prediction;
+
    /*
     * tbox::Timer objects for performance measurement.
     */
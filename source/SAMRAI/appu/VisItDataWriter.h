@@ -34,6 +34,7 @@
 
 #include <string>
 #include <list>
+#include <map>
 #include <vector>
 #include <memory>
 
@@ -96,7 +97,8 @@ namespace appu {
  *       common dump file.  This can reduce parallel I/O contention.
  *       The default value of this arg is 1.  If the value specified
  *       is greater than the number of processors, then all processors
- *       share a single dump file.
+ *       share a single dump file.  The first processor of each cluster
+ *       is its writer; the other processors send it their plot data.
  *
  *    - Register hierarchy variable data fields using
  *      registerPlotQuantity(). The variables registered may be scalar,
@@ -175,9 +177,14 @@ public:
     * number_procs_per_file is greater than the number of processors,
     * then all processors share a single vis dump file.  Reducing the
     * number of files written may reduce parallel I/O contention and
-    * thus improve I/O efficiency.  The optional argument is_multiblock
-    * defaults to false.  It must be set to true for problems on multiblock
-    * domains, and left false in all other cases.
+    * thus improve I/O efficiency.  Only the first processor of each
+    * file cluster opens the file; the other processors of the cluster
+    * send it their plot data and patch min/max information, and it
+    * writes the min/max information of the cluster to the summary
+    * file, of which the master writes only the index.  The optional
+    * argument is_multiblock defaults to false.  It must be set to true
+    * for problems on multiblock domains, and left false in all other
+    * cases.
     *
     * Before the data writer object can be used for dumping VisIt
     * data, the variables and material-related data (if any) must be
@@ -719,6 +726,68 @@ public:
       d_write_ghosts = write_ghosts; 
    }
 
+   /*!
+    * @brief Set lossless compression of the plot data files.
+    *
+    * See tbox::HDFDatabase::setCompression().  VisIt reads the
+    * compressed files through its HDF5 library without any setting.
+    *
+    * @param deflate_level  Deflate level 1 to 9, or 0 for none
+    * @param shuffle        Whether to shuffle bytes before deflating
+    *
+    * @pre deflate_level >= 0 && deflate_level <= 9
+    */
+   void
+   setCompression(
+      const int deflate_level,
+      const bool shuffle = true)
+   {
+      TBOX_ASSERT(deflate_level >= 0 && deflate_level <= 9);
+      d_deflate_level = deflate_level;
+      d_shuffle = shuffle;
+   }
+
+   /*!
+    * @brief Write a registered plot quantity with bounded error.
+    *
+    * The values of the variable, after scaling, are stored truncated to
+    * decimal_digits digits after the decimal point, so the absolute
+    * error is at most 1e-decimal_digits (see
+    * tbox::HDFDatabase::setLossyCompression()).  A negative value
+    * restores the default float output.
+    *
+    * An error results and the program will halt if the variable was
+    * not registered.
+    *
+    * @param variable_name name of a registered variable.
+    * @param decimal_digits number of decimal digits kept.
+    *
+    * @pre !variable_name.empty()
+    */
+   void
+   setPlotQuantityPrecision(
+      const std::string& variable_name,
+      const int decimal_digits);
+
+   /*!
+    * @brief Write the plot data of all processors to a single shared
+    * file.
+    *
+    * In this mode, which overrides number_procs_per_file, every
+    * processor writes its own plot data and summary min/max information
+    * through parallel HDF5 instead of sending them to a file cluster
+    * writer.  Compression and setPlotQuantityPrecision() are not applied
+    * to the shared file.
+    *
+    * An error results and the program will halt if single_shared_file
+    * is true and HDF5 was built without parallel support.
+    *
+    * @param single_shared_file  Whether to write a single shared file
+    */
+   void
+   setSingleSharedFile(
+      const bool single_shared_file);
+
 private:
    /*
     * Static integer constant describing version of VisIt Data Writer.
@@ -754,9 +823,13 @@ private:
    static const int VISIT_MASTER;
 
    /*
-    * Static integer constant describing MPI message tag.
+    * Static integer constants describing MPI message tags.
     */
-   static const int VISIT_FILE_CLUSTER_WRITE_BATON;
+   static const int VISIT_FILE_CLUSTER_SIZE_TAG;
+   static const int VISIT_FILE_CLUSTER_DATA_TAG;
+   static const int VISIT_MIN_MAX_SIZE_TAG;
+   static const int VISIT_MIN_MAX_DATA_TAG;
+   static const int VISIT_SUMMARY_TURN_TAG;
 
    /*
     * Static boolean that specifies if the summary file (d_summary_filename)
@@ -875,8 +948,9 @@ private:
     *                   name[1]  = d_variable_name.01,
     *                   ..
     *                   name[nn] = d_variable_name.nn
-    *   d_master_min_max - ptr to min/max struct on master for each
-    *      var.  This is used to gather the min max info for all patches.
+    *   d_cluster_min_max - ptr to min/max struct on a file cluster
+    *      writer for each var.  This holds the min max info for the
+    *      patches of the cluster, in the order of d_cluster_patch_ids.
     *   d_deformed_coord_id - id of vector defining deformed coordinates
     *   d_coord_scale_factor - scale factor of the different deformed coords
     *   d_level_start_depth_index - int array specifying start depth on
@@ -916,6 +990,8 @@ private:
       //   material state variable treatment?
       //bool d_is_species_state_variable;
       std::vector<int> d_ghost_width;
+      // decimal digits kept, or -1 for exact float output
+      int d_decimal_digits;
 
       /*
        * Standard information (writer generated)
@@ -924,7 +1000,7 @@ private:
       variable_data_type d_var_data_type;
       std::vector<std::string> d_visit_var_name;
       struct patchMinMaxStruct *
-      d_master_min_max[VISIT_MAX_NUMBER_COMPONENTS];
+      d_cluster_min_max[VISIT_MAX_NUMBER_COMPONENTS];
       std::vector<int> d_level_patch_data_index;
       std::vector<double> d_coord_scale_factor;
 
@@ -1076,13 +1152,16 @@ private:
       const void* s2);
 
    /*
-    * Barrier functions to enable orderly writing of cluster files by
-    * passing a baton from current writer to next proc in cluster.
+    * Copy the plot data a cluster member sent to its writer into the
+    * member's processor group of the cluster file.  Float arrays of
+    * quantities listed in precisions are written with the given number
+    * of decimal digits.
     */
    void
-   dumpWriteBarrierBegin();
-   void
-   dumpWriteBarrierEnd();
+   copyPlotDataToClusterFile(
+      tbox::Database& group,
+      const std::shared_ptr<tbox::Database>& member_group,
+      const std::map<std::string, int>& precisions);
 
    /*
     * Write summary data for VisIt to HDF file.
@@ -1098,7 +1177,7 @@ private:
    /*
     * Helper method for writeSummaryToHDFFile() method above.
     * Performs tbox::MPI communications to send min/max information for all
-    * variables on all patches to the VISIT_MASTER.
+    * variables on the patches of a file cluster to the cluster writer.
     */
    void
    exchangeMinMaxPatchInformation(
@@ -1106,6 +1185,70 @@ private:
       const int coarsest_plot_level,
       const int finest_plot_level);
 
+   /*
+    * Helper method for exchangeMinMaxPatchInformation() method above.
+    * Unpacks the min/max information of the patches owned by
+    * sending_proc into the cluster writer's min/max arrays.
+    */
+   void
+   unpackMinMaxPatchInformation(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int coarsest_plot_level,
+      const int finest_plot_level,
+      const int sending_proc,
+      const patchMinMaxStruct* buf);
+
+   /*
+    * Helper method for writeSummaryToHDFFile() method above.  Writes
+    * the min/max rows of d_cluster_patch_ids to the open summary file.
+    */
+   void
+   writeMinMaxToSummaryHDFFile(
+      const hid_t file_id,
+      const hid_t xfer_plist);
+
+   /*
+    * Return the path of the min/max dataset of a plot item component
+    * in the summary file.
+    */
+   std::string
+   getMinMaxDatasetName(
+      const VisItItem& plotitem,
+      const int comp) const;
+
+#ifdef H5_HAVE_PARALLEL
+   /*
+    * A group or dataset of the plot data of a processor, used by the
+    * single shared file mode.  group and key locate the data of a
+    * dataset of this processor.
+    */
+   struct sharedFileEntry {
+      std::string path;
+      int type;
+      int size;
+      std::shared_ptr<tbox::Database> group;
+      std::string key;
+   };
+
+   /*
+    * Write the plot data of all processors to the single shared file.
+    */
+   void
+   writeSharedHDFFile(
+      const std::string& filename,
+      const std::shared_ptr<tbox::Database>& processor_group);
+
+   /*
+    * Helper method for writeSharedHDFFile() method above.  Lists the
+    * groups and datasets under the given group.
+    */
+   void
+   listSharedFileEntries(
+      const std::shared_ptr<tbox::Database>& group,
+      const std::string& path,
+      std::vector<sharedFileEntry>& entries);
+#endif
+
    /*
     * Pack dim patch data into 1D double precision buffer,
     * eliminating ghost data if necessary
@@ -1132,6 +1275,15 @@ private:
       const int nelements1,
       const hid_t group_id);
 
+   /*
+    * Set the lossy precision of the float arrays next written to the
+    * given HDF patch group; a negative value restores exact output.
+    */
+   void
+   setPlotDataPrecision(
+      tbox::Database& group,
+      const int decimal_digits);
+
    /*
     * Create a 2D double array entry in the database with the specified
     * key name.
@@ -1176,14 +1328,19 @@ private:
       const int nelements,
       const hid_t group_id);
 
+   /*
+    * Create the HDF compound type of the min/max struct.
+    */
+   hid_t
+   createPatchMinMaxType();
+
    /*
     * Create an array of min/max structs in the database with
-    * the specified key name.
+    * the specified key name, to be filled in by the cluster writers.
     */
    void
-   HDFputPatchMinMaxStructArray(
+   HDFcreatePatchMinMaxStructArray(
       const std::string& key,
-      const patchMinMaxStruct* data,
       const int nelements,
       const hid_t group_id);
 
@@ -1271,11 +1428,6 @@ private:
     */
    int d_time_step_number;
 
-   /*
-    * Number of worker processors that pass info to VISIT_MASTER
-    */
-   int d_number_working_slaves;
-
    /*
     * Cluster information for parallel runs. A file_cluster
     * is a set of processors that all write VisIt data to
@@ -1291,6 +1443,18 @@ private:
    int d_my_rank_in_file_cluster;
    int d_number_files_this_file_cluster;
 
+   /*
+    * Whether all processors write to a single shared file through
+    * parallel HDF5; see setSingleSharedFile().
+    */
+   bool d_single_shared_file;
+
+   /*
+    * Increasing global numbers of the patches whose min/max information
+    * this processor writes to the summary file.
+    */
+   std::vector<int> d_cluster_patch_ids;
+
    /*
     * Number of registered VisIt variables, materials, and species.
     * Each regular and derived and variable (i.e. variables registered with
@@ -1313,10 +1477,10 @@ private:
    int d_number_species;
 
    /*
-    * For parallel runs, this array of min/max structs holds the summary
-    * information all local patches on workers prior to being sent to
-    * master.  It is filled in this order: by level, then by
-    * local_patch_number, then by var_item, then by component_number.
+    * This array of min/max structs holds the summary information of
+    * all local patches prior to being sent to the file cluster writer.
+    * It is filled in this order: by level, then by local_patch_number,
+    * then by var_item, then by component_number.
     */
    patchMinMaxStruct* d_worker_min_max;
    int d_var_id_ctr;
@@ -1337,6 +1501,12 @@ private:
     */
    bool d_write_ghosts;
 
+   /*
+    * Lossless compression of the plot data files.
+    */
+   int d_deflate_level;
+   bool d_shuffle;
+
    /*
     * brief Storage for strings defining VisIt expressions to be embedded in
     * the plot dump.
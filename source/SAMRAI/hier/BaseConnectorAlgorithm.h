@@ -73,6 +73,28 @@ protected:
       const std::shared_ptr<tbox::Timer>& receive_and_unpack_timer,
       bool print_steps) const;
 
+   /*!
+    * @brief Unpack a discovery message held in a buffer.
+    *
+    * The message may be a section of a larger buffer.  Offsets stored
+    * in the message are relative to @c mesg.
+    *
+    * @param[in] sender Rank of the process that sent the message.
+    * @param[in] mesg Start of the message.
+    * @param[in] mesg_size Number of ints in the message.
+    * @param[in,out] west_to_east
+    * @param[in,out] east_to_west
+    * @param[in] print_steps
+    */
+   void
+   unpackDiscoveryMessage(
+      int sender,
+      const int* mesg,
+      int mesg_size,
+      Connector& west_to_east,
+      Connector* east_to_west,
+      bool print_steps) const;
+
 private:
    /*
     * Data length limit on first message of a communication.
@@ -17,6 +17,8 @@
 #include "SAMRAI/tbox/Database.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace SAMRAI {
 namespace hier {
@@ -34,9 +36,15 @@ namespace hier {
  * Combined with a BlueprintUtilsStrategy, this loops over a hierarchy,
  * fills Blueprint topology and coordinate entries, calls back to user code
  * for specific coord choices:  uniform, rectilinear, explicit
+ *
+ * For in-situ analysis, publishBlueprintMesh() keeps a blueprint of the
+ * hierarchy in a conduit node that the application owns.  The fields
+ * registered with registerBlueprintField() are external references to
+ * the patch data buffers, so consumers read them without a copy.
  */
 
 class PatchHierarchy;
+class PatchLevel;
 
 class BlueprintUtils
 {
@@ -104,10 +112,75 @@ public:
       const std::string& rootfile_name,
       const std::string& io_protocol) const;
 
+   /*!
+    * @brief Register a field to be published by publishBlueprintMesh().
+    *
+    * The patch data of the field must override
+    * PatchData::putBlueprintField().
+    *
+    * @param field_name     Name of the field in the blueprint
+    * @param patch_data_id  Patch data index of the field
+    * @param depth          Depth of the patch data published as the field
+    *
+    * @pre !field_name.empty()
+    * @pre patch_data_id >= 0
+    * @pre depth >= 0
+    */
+   void registerBlueprintField(
+      const std::string& field_name,
+      int patch_data_id,
+      int depth = 0);
+
+   /*!
+    * @brief Publish the hierarchy to a blueprint for in-situ consumers.
+    *
+    * The mesh description (state, nestsets, topologies and coordsets) is
+    * rebuilt only when the hierarchy changed since the last call with the
+    * same node, i.e. when a level was added, removed or regridded.
+    * Otherwise only the time, the cycle and the external references to the
+    * field buffers are refreshed.  No field data is copied; the buffers
+    * remain owned by the patch data and the node must not be used after
+    * the hierarchy has been regridded without publishing it again.
+    *
+    * @param blueprint  Node to hold the local blueprint
+    * @param hierarchy  The hierarchy being described
+    * @param time       Simulation time put into each domain's state
+    * @param cycle      Cycle number put into each domain's state
+    *
+    * @return true if the mesh description was rebuilt
+    */
+   bool publishBlueprintMesh(
+      conduit::Node& blueprint,
+      const PatchHierarchy& hierarchy,
+      double time,
+      int cycle);
+
 private:
 
+   /*
+    * Return true if the levels of the hierarchy are not those
+    * published last.
+    */
+   bool hierarchyChangedSincePublished(
+      const PatchHierarchy& hierarchy) const;
+
    BlueprintUtilsStrategy* d_strategy;
 
+   /*
+    * Names, patch data indices and depths of the fields published by
+    * publishBlueprintMesh().
+    */
+   std::vector<std::string> d_field_names;
+   std::vector<int> d_field_ids;
+   std::vector<int> d_field_depths;
+
+   /*
+    * Node and levels of the last publishBlueprintMesh() call.  A level
+    * that has been replaced or destroyed no longer matches.
+    */
+   const conduit::Node* d_published_node;
+   std::vector<std::weak_ptr<PatchLevel> > d_published_levels;
+
 };
 
 }
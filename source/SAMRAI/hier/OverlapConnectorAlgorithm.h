@@ -16,6 +16,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 namespace SAMRAI {
 namespace hier {
@@ -413,6 +414,103 @@ public:
       const Connector& center_to_east,
       const IntVector& connector_width_limit) const;
 
+   /*!
+    * @brief Specification of one bridge operation in a batch of bridges
+    * computed by bridgeBatch().
+    *
+    * The input members have the same meanings as the corresponding
+    * arguments of bridgeWithNesting().  A negative nesting growth means
+    * the nesting is unknown, as in bridge().  A negative
+    * connector_width_limit means there is no user-imposed limit.
+    *
+    * d_west_to_east is the output of the bridge.  It is set by
+    * bridgeBatch() and, if d_compute_transpose is true, has its
+    * transpose set.
+    */
+   struct BridgeRequest {
+      /*!
+       * @brief Constructor for a bridge without any guarantee of nesting.
+       *
+       * @param[in] west_to_center
+       * @param[in] center_to_east
+       * @param[in] connector_width_limit
+       * @param[in] compute_transpose
+       */
+      BridgeRequest(
+         const Connector& west_to_center,
+         const Connector& center_to_east,
+         const IntVector& connector_width_limit,
+         bool compute_transpose):
+         d_west_to_center(&west_to_center),
+         d_center_to_east(&center_to_east),
+         d_center_growth_to_nest_west(connector_width_limit.getDim(), -1),
+         d_center_growth_to_nest_east(connector_width_limit.getDim(), -1),
+         d_connector_width_limit(connector_width_limit),
+         d_compute_transpose(compute_transpose) {
+      }
+
+      /*!
+       * @brief Constructor for a bridge with nesting specifications.
+       *
+       * @param[in] west_to_center
+       * @param[in] center_to_east
+       * @param[in] center_growth_to_nest_west
+       * @param[in] center_growth_to_nest_east
+       * @param[in] connector_width_limit
+       * @param[in] compute_transpose
+       */
+      BridgeRequest(
+         const Connector& west_to_center,
+         const Connector& center_to_east,
+         const IntVector& center_growth_to_nest_west,
+         const IntVector& center_growth_to_nest_east,
+         const IntVector& connector_width_limit,
+         bool compute_transpose):
+         d_west_to_center(&west_to_center),
+         d_center_to_east(&center_to_east),
+         d_center_growth_to_nest_west(center_growth_to_nest_west),
+         d_center_growth_to_nest_east(center_growth_to_nest_east),
+         d_connector_width_limit(connector_width_limit),
+         d_compute_transpose(compute_transpose) {
+      }
+
+      const Connector* d_west_to_center;
+      const Connector* d_center_to_east;
+      IntVector d_center_growth_to_nest_west;
+      IntVector d_center_growth_to_nest_east;
+      IntVector d_connector_width_limit;
+      bool d_compute_transpose;
+      std::shared_ptr<Connector> d_west_to_east;
+   };
+
+   /*!
+    * @brief Compute several independent bridges with a single
+    * aggregated communication phase.
+    *
+    * Each bridge is computed as by bridgeWithNesting().  Rather than
+    * exchanging remote neighbor data once per bridge, the
+    * discoveries for all bridges are packed into one message per peer
+    * process and shared using one AsyncCommStage.  This reduces the
+    * number of latency-bound message rounds when several Connectors
+    * can be computed at once.  The bridges of regridding itself each
+    * use the result of the previous one and cannot be batched, but
+    * CascadePartitioner batches its two bridges between the current
+    * and workload levels.
+    *
+    * The bridges must be independent: no request may use the output
+    * of another request in the same batch.  All Connectors must have
+    * SAMRAI_MPI objects congruent with the one used by this object.
+    *
+    * @param[in,out] requests The bridges to compute.  On return, each
+    * request's d_west_to_east holds its result.
+    *
+    * @pre for each request, d_west_to_center->hasTranspose()
+    * @pre for each request, d_center_to_east->hasTranspose()
+    */
+   void
+   bridgeBatch(
+      std::vector<BridgeRequest>& requests) const;
+
    /*!
     * @brief Set whether to barrier before potential major
     * communication.
@@ -586,6 +684,18 @@ private:
       const Connector& east_to_cent,
       const Connector& cent_to_west) const;
 
+   /*!
+    * @brief Receive the aggregated messages of bridgeBatch() and unpack
+    * each message section into the Connectors of its bridge.
+    */
+   void
+   privateBridgeBatch_receiveAndUnpack(
+      std::vector<BridgeRequest>& requests,
+      const std::vector<Connector *>& east_to_wests,
+      const std::set<int>& incoming_ranks,
+      tbox::AsyncCommPeer<int>* all_comms,
+      tbox::AsyncCommStage& comm_stage) const;
+
    /*!
     * @brief Relationship removal part of overlap algorithm, caching
     * outgoing information in message buffers.
@@ -600,6 +710,9 @@ private:
    /*!
     * @brief Find all relationships in the Connector(s) to be computed and send
     * outgoing information.
+    *
+    * If all_comms is null, the outgoing information is left in
+    * send_mesgs for the caller to send.
     */
    void
    privateBridge_discoverAndSend(
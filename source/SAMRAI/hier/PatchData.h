@@ -237,6 +237,28 @@ public:
    putToRestart(
       const std::shared_ptr<tbox::Database>& restart_db) const;
 
+#ifdef SAMRAI_HAVE_CONDUIT
+   /**
+    * @brief Put the data at the given depth into a conduit node as a
+    * field of the blueprint format.
+    *
+    * Concrete patch data types that can be described by the blueprint
+    * override this to reference their data buffer without copying it.
+    * The default implementation is an unrecoverable error.
+    *
+    * @param domain_node   Node holding blueprint data for one patch
+    * @param field_name    Name of this field
+    * @param topology_name Identifier of the topology for this field
+    * @param depth         Use the data at this depth
+    */
+   virtual void
+   putBlueprintField(
+      conduit::Node& domain_node,
+      const std::string& field_name,
+      const std::string& topology_name,
+      int depth = 0);
+#endif
+
    /**
     * @brief Return the dimension of this object.
     */
@@ -269,6 +291,52 @@ protected:
       d_ghost_box = ghost_box;
    }
 
+#ifdef SAMRAI_HAVE_CONDUIT
+   /**
+    * Put size values starting at data into the "values" node of a
+    * blueprint field, as an external reference to data if external is
+    * true and as a copy otherwise.  Concrete patch data types use this
+    * in putBlueprintField(); values of types that the blueprint cannot
+    * describe are an unrecoverable error.
+    */
+   static void
+   putBlueprintValues(
+      conduit::Node& values_node,
+      double* data,
+      size_t size,
+      bool external);
+
+   static void
+   putBlueprintValues(
+      conduit::Node& values_node,
+      float* data,
+      size_t size,
+      bool external);
+
+   static void
+   putBlueprintValues(
+      conduit::Node& values_node,
+      int* data,
+      size_t size,
+      bool external);
+
+   template<class TYPE>
+   static void
+   putBlueprintValues(
+      conduit::Node& values_node,
+      TYPE* data,
+      size_t size,
+      bool external)
+   {
+      NULL_USE(values_node);
+      NULL_USE(data);
+      NULL_USE(size);
+      NULL_USE(external);
+      TBOX_ERROR("PatchData::putBlueprintValues error...\n"
+         << "the data type cannot be put into a blueprint." << std::endl);
+   }
+#endif
+
 private:
    /*
     * Static integer constant describing class's version number.
@@ -13,13 +13,30 @@
 
 #include "SAMRAI/SAMRAI_config.h"
 #include "SAMRAI/hier/ComponentSelector.h"
+#include "SAMRAI/tbox/Database.h"
 #include "SAMRAI/tbox/StartupShutdownManager.h"
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
 namespace SAMRAI {
 namespace hier {
 
+class PatchData;
+
 /**
  * Class PatchDataRestartManager handles registration of PatchData for restart.
+ *
+ * It also writes the patch data items for restart.  When the
+ * tbox::RestartManager writes incremental restarts, each item is
+ * serialized into memory and hashed, and an item whose hash is unchanged
+ * since the previous restart of the same directory is written as a
+ * reference to the restart that holds its data instead of being written
+ * again.  The time stamp of a patch data item is not hashed but is
+ * always written, so data that is only advanced in time is still
+ * referenced.
  */
 
 class PatchDataRestartManager
@@ -91,6 +108,23 @@ public:
       return selected == d_patchdata_restart_table;
    }
 
+   /**
+    * Write a patch data item to the restart database, or a reference to
+    * an earlier restart if the item is unchanged and incremental restarts
+    * are being written.
+    *
+    * @param[in]  patch_data  The patch data to write.
+    * @param[in]  key  Name of the item that is unique among the items
+    *             written by this process to one restart and the same in
+    *             successive restarts.
+    * @param[in]  restart_db  Database of the patch data item.
+    */
+   void
+   putPatchDataToRestart(
+      const PatchData& patch_data,
+      const std::string& key,
+      const std::shared_ptr<tbox::Database>& restart_db);
+
 private:
    /**
     * The constructor for PatchDataRestartManager is private.
@@ -125,6 +159,25 @@ private:
    static void
    shutdownCallback();
 
+   /*
+    * Return hash combined with the FNV-1a hash of the keys and values in
+    * db.  The time stamp of the patch data at the top level is skipped.
+    */
+   static uint64_t
+   hashRestartDatabase(
+      tbox::Database& db,
+      uint64_t hash,
+      bool top_level);
+
+   /*
+    * Hash of a patch data item and the restore number of the restart
+    * holding its data.
+    */
+   struct IncrementalRecord {
+      uint64_t hash;
+      int restore_num;
+   };
+
    static PatchDataRestartManager* s_manager_instance;
 
    /*
@@ -135,6 +188,16 @@ private:
     */
    ComponentSelector d_patchdata_restart_table;
 
+   /*
+    * Records of the items written to the previous restart, which may be
+    * referenced, and to the restart being written, by item key.  The
+    * records are for the restart directory and restore number below.
+    */
+   std::map<std::string, IncrementalRecord> d_written_records;
+   std::map<std::string, IncrementalRecord> d_writing_records;
+   std::string d_records_dirname;
+   int d_records_restore_num;
+
    static tbox::StartupShutdownManager::Handler s_shutdown_handler;
 };
 
@@ -1031,6 +1031,18 @@ public:
    void
    initializeHierarchy();
 
+   /*!
+    * @brief Replace the patch levels by those in the restart database.
+    *
+    * All levels are removed and the levels are read from the root
+    * restart database as by initializeHierarchy(), which is used to roll
+    * a running simulation back to a checkpoint such as one opened by
+    * tbox::RestartManager::openMemoryCheckpoint().  The hierarchy
+    * parameters are not read again.
+    */
+   void
+   resetFromRestart();
+
    /*!
     * @brief Get the dimension of this object.
     *
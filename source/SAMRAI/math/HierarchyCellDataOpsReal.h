@@ -512,6 +512,28 @@ public:
       const int vol_id = -1,
       bool local_only = false) const;
 
+   /**
+    * Set \f$d = \alpha s_1 + \beta s_2\f$ on the patch interiors and
+    * return the dot product of d with the data at dot_id, computing both
+    * on each patch before moving to the next.  The dot product is
+    * weighted by the control volume as in dot().  If local_only is true,
+    * the global reduction is not performed.
+    *
+    * @pre getPatchHierarchy()
+    * @pre (d_coarsest_level >= 0) && (d_finest_level >= d_coarsest_level) &&
+    *      (d_finest_level <= getPatchHierarchy()->getFinestLevelNumber())
+    */
+   TYPE
+   linearSumDot(
+      const int dst_id,
+      const TYPE& alpha,
+      const int src1_id,
+      const TYPE& beta,
+      const int src2_id,
+      const int dot_id,
+      const int vol_id = -1,
+      bool local_only = false) const;
+
    /**
     * Return the integral of the function represented by the data array.
     * The return value is the sum \f$\sum_i ( data_i * vol_i )\f$.
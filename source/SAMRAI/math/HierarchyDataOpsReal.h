@@ -387,6 +387,28 @@ public:
       const int vol_id = -1,
       bool local_only = false) const = 0;
 
+   /**
+    * Set \f$d = \alpha s_1 + \beta s_2\f$ on the patch interiors and
+    * return the dot product of d with the data at dot_id, weighted by the
+    * control volume as in dot().  dot_id may be dst_id, giving the square
+    * of the \f$L_2\f$-norm of the result.  If local_only is true, the
+    * global reduction is not performed.
+    *
+    * The default implementation calls linearSum() and then dot().
+    * Subclasses may override it to compute both in one pass over the
+    * patches, while the data of each patch is in cache.
+    */
+   virtual TYPE
+   linearSumDot(
+      const int dst_id,
+      const TYPE& alpha,
+      const int src1_id,
+      const TYPE& beta,
+      const int src2_id,
+      const int dot_id,
+      const int vol_id = -1,
+      bool local_only = false) const;
+
    /**
     * Return 1 if \f$\|data2_i\| > 0\f$ and \f$data1_i * data2_i \leq 0\f$, for
     * any \f$i\f$ in the set of patch data indices, where \f$cvol_i > 0\f$.  Otherwise,
@@ -439,7 +439,7 @@ public:
     * @param topology_name Identifier of the topology for this field
     * @param depth         Use the data at this depth
     */
-   void
+   virtual void
    putBlueprintField(
       conduit::Node& domain_node,
       const std::string& field_name,
@@ -47,6 +47,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace solv {
@@ -75,7 +76,11 @@ namespace solv {
  * This class provides:
  * -# 5-point (second order), cell-centered stencil operations
  *    for the discrete Laplacian.
- * -# Red-black Gauss-Seidel smoothing.
+ * -# Red-black Gauss-Seidel smoothing, optionally doing several sweeps
+ *    per ghost exchange, or Chebyshev polynomial smoothing
+ *    (see smoothing_choice below).
+ * -# A geometric multigrid solver for the coarsest level that needs
+ *    no external library (see coarse_solver_choice below).
  * -# Provisions for working Robin boundary conditions
  *    (see RobinBcCoefStrategy).
  *
@@ -112,6 +117,23 @@ namespace solv {
  *
  *    - \b    coarse_solver_max_iterations
  *
+ *    - \b    gmg_num_sweeps
+ *       red-black sweeps before and after the coarse-grid correction on
+ *       each level of the "gmg" coarse solver.
+ *
+ *    - \b    gmg_max_levels
+ *       maximum number of grid resolutions used by the "gmg" coarse
+ *       solver, counting the coarsest level of the solve.
+ *
+ *    - \b    gmg_agglomeration_threshold
+ *       when the average number of cells per process owning boxes of a
+ *       "gmg" level falls below this value, the level is redistributed
+ *       onto fewer processes before it is coarsened further.
+ *
+ *    - \b    gmg_bottom_max_sweeps
+ *       maximum number of red-black sweeps used to solve on the
+ *       coarsest "gmg" level.
+ *
  *    - \b    cf_discretization
  *
  *    - \b    prolongation_method
@@ -132,7 +154,7 @@ namespace solv {
  *     <td>coarse_solver_choice</td>
  *     <td>string</td>
  *     <td>"hypre"</td>
- *     <td>"hypre", "redblack", "jacobi"</td>
+ *     <td>"hypre", "redblack", "jacobi", "gmg"</td>
  *     <td>opt</td>
  *     <td>Not written to restart.  Value in input db used.</td>
  *   </tr>
@@ -153,6 +175,81 @@ namespace solv {
  *     <td>Not written to restart.  Value in input db used.</td>
  *   </tr>
  *   <tr>
+ *     <td>gmg_num_sweeps</td>
+ *     <td>int</td>
+ *     <td>2</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>gmg_max_levels</td>
+ *     <td>int</td>
+ *     <td>10</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>gmg_agglomeration_threshold</td>
+ *     <td>int</td>
+ *     <td>512</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>gmg_bottom_max_sweeps</td>
+ *     <td>int</td>
+ *     <td>100</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>smoothing_choice</td>
+ *     <td>string</td>
+ *     <td>"redblack"</td>
+ *     <td>"redblack", "chebyshev"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>smoothing_sweeps_per_ghost_fill</td>
+ *     <td>int</td>
+ *     <td>1</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>chebyshev_eigenvalue_ratio</td>
+ *     <td>double</td>
+ *     <td>4.0</td>
+ *     <td>>1.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>smoothing_kernel</td>
+ *     <td>string</td>
+ *     <td>"fortran"</td>
+ *     <td>"fortran", "cxx"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>smoothing_precision</td>
+ *     <td>string</td>
+ *     <td>"double"</td>
+ *     <td>"double", "float"; "float" requires smoothing_kernel = "cxx",
+ *         smoothing_choice = "redblack", smoothing_sweeps_per_ghost_fill
+ *         = 1, cf_discretization = "Ewing" and prolongation_method =
+ *         "CONSTANT_REFINE"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
  *     <td>cf_discretization</td>
  *     <td>string</td>
  *     <td>"Ewing"</td>
@@ -178,6 +275,92 @@ namespace solv {
  *   </tr>
  * </table>
  *
+ * The "gmg" coarse solver runs V-cycles of geometric multigrid on the
+ * coarsest level of the solve.  In initializeOperatorState(), the
+ * coarsest level is repeatedly coarsened by a factor of 2 into private
+ * patch levels (not in the hierarchy) for as long as every box stays
+ * aligned with the coarser index space.  A coarsened level keeps the
+ * boxes and owners of its finer level, so restriction and prolongation
+ * between them are local.  When a level becomes too small for the
+ * processes owning it, its boxes are gathered onto fewer processes and
+ * coalesced, which lets coarsening continue.  The diffusion and scalar
+ * field coefficients are averaged onto the multigrid levels at the same
+ * time, so, as with the "hypre" solver, they must be set before
+ * initializeOperatorState() is called.  V-cycles are run until the
+ * maximum residual is below coarse_solver_tolerance or
+ * coarse_solver_max_iterations cycles have been run.
+ *
+ * With smoothing_sweeps_per_ghost_fill = k > 1, the red-black smoother
+ * fills a ghost region 2k cells wide once and then does k sweeps on
+ * each patch grown into that region, shrinking the updated region by
+ * one cell after each half sweep.  Ghost cells not covered by another
+ * patch of the level keep their filled values, except that physical
+ * boundary conditions are reapplied after each half sweep.  Each patch
+ * thus repeats some of its neighbors' work in exchange for exchanging
+ * ghost data 2k times less often.  Up to rounding, the result is that
+ * of k ordinary sweeps, unless a refinement ratio above 2 puts Ewing's
+ * coarse-fine correction out of reach near the edge of the wide
+ * region.  The wide copies of the Poisson
+ * coefficients are made in initializeOperatorState(), so, as with the
+ * "gmg" solver, the coefficients must be set before then.  Choosing
+ * k > 1 registers the wide variables in the constructor, which must
+ * therefore run before the hierarchy is built.
+ *
+ * The "chebyshev" smoother applies a Chebyshev polynomial in the
+ * Jacobi-preconditioned operator, one degree per sweep.  It needs one
+ * ghost exchange per sweep and no ordering of the cells.  The largest
+ * eigenvalue of the preconditioned operator is bounded by 2, and the
+ * smoother targets the eigenvalues between 2/chebyshev_eigenvalue_ratio
+ * and 2.
+ *
+ * The red-black and jacobi coarse solvers, which iterate to a residual
+ * tolerance, always use ordinary red-black sweeps.
+ *
+ * With smoothing_kernel = "cxx", the ordinary red-black sweeps and the
+ * residual are computed by C++ loops instead of the Fortran kernels.
+ * The sweeps compute fluxes as they go instead of storing them, and
+ * Ewing's coarse-fine correction is folded into temporary values of
+ * the coarse-fine ghost cells.  The first pass of a sweep updates the
+ * red cells and, one row (plane in 3D) behind them, the black cells
+ * not next to a ghost cell, so most of a patch is read once per sweep.
+ * The remaining black cells are updated after the ghost exchange.  On
+ * the finest level of the solve the composite residual is computed in
+ * the same pass as the fluxes.  When SAMRAI is built with OpenMP, the
+ * patches of a level are divided among the threads, or, if there are
+ * fewer patches than threads, the rows or planes of each patch are.
+ *
+ * The C++ kernels also cache the stencil of the operator on each
+ * patch of the solve: the face coefficients D/h^2 and the diagonal,
+ * with the homogeneous physical Robin conditions folded into the
+ * diagonal of the boundary cells.  The stencil is built once in
+ * initializeOperatorState(), and the red-black sweeps and the Jacobi
+ * diagonal of the "chebyshev" smoother read it instead of D and C.
+ * setPoissonSpecifications() refreshes the cached stencil: if only C
+ * changed, just the diagonal is updated.  D is read only while
+ * building the stencil, so a change to the values of D must be
+ * followed by initializeOperatorState().  Only the sweeps read the
+ * cached stencil.  The residual and fluxes are still computed from D
+ * and C, because the composite residual needs the fluxes for the
+ * coarse-fine correction and the inhomogeneous boundary values, and
+ * the hypre coarse solver assembles its matrix from its own copy of
+ * the specifications.  The Fortran kernels never use the cache.
+ *
+ * With smoothing_precision = "float", each FAC cycle is done in
+ * single precision by applyReducedPrecisionCycle(): the residual is
+ * converted to single precision, and the sweeps, the residuals of the
+ * error equation, the restriction and the prolongation work on single
+ * precision correction and scratch data with a single precision copy
+ * of the stencil.  Only the coarsest level is solved in double
+ * precision, by the coarse solver.  FACPreconditioner adds the
+ * correction to the solution and recomputes the composite residual in
+ * double precision, so each cycle is a step of iterative refinement
+ * and the solution still converges to the double precision tolerance.
+ * The single precision residuals are computed from the stencil alone,
+ * so on a level with a finer level they lack the composite flux
+ * correction at the coarse-fine interface; the double precision
+ * residual of the next cycle makes up for it.  The correction is
+ * prolonged by constant refinement, which needs no boundary values,
+ * so "float" requires prolongation_method = "CONSTANT_REFINE".
  */
 class CellPoissonFACOps:
    public FACOperatorStrategy
@@ -227,13 +410,15 @@ public:
 
    /*!
     * @brief Set the scalar Poisson equation specifications.
+    *
+    * If the stencil is cached (see the class description), it is
+    * refreshed for the new specifications.  When D is unchanged,
+    * only the C contribution to the diagonal is recomputed, which
+    * also picks up new values of a variable C.
     */
    void
    setPoissonSpecifications(
-      const PoissonSpecifications& spec)
-   {
-      d_poisson_spec = spec;
-   }
+      const PoissonSpecifications& spec);
 
    //@{
    /*!
@@ -465,6 +650,23 @@ public:
       const SAMRAIVectorReal<double>& current_soln,
       const SAMRAIVectorReal<double>& residual);
 
+   /*!
+    * @brief Whether the FAC cycles are done in single precision, that
+    * is, whether smoothing_precision is "float" and the stencil is
+    * cached.
+    */
+   virtual bool
+   hasReducedPrecisionCycle() const;
+
+   virtual void
+   applyReducedPrecisionCycle(
+      SAMRAIVectorReal<double>& error,
+      SAMRAIVectorReal<double>& residual,
+      int fine_ln,
+      int coarse_ln,
+      int num_pre_sweeps,
+      int num_post_sweeps);
+
    //@}
 
    /*!
@@ -522,6 +724,164 @@ private:
       int num_sweeps,
       double residual_tolerance = -1.0);
 
+   /*!
+    * @brief Red-black Gauss-Seidel error smoothing on a level with the
+    * C++ kernels.
+    *
+    * Same arguments and results as smoothErrorByRedBlack().
+    */
+   void
+   smoothErrorByThreadedRedBlack(
+      SAMRAIVectorReal<double>& error,
+      const SAMRAIVectorReal<double>& residual,
+      int ln,
+      int num_sweeps,
+      double residual_tolerance = -1.0);
+
+   /*!
+    * @brief Red-black Gauss-Seidel error smoothing doing
+    * d_smoothing_sweeps_per_ghost_fill sweeps per ghost exchange.
+    *
+    * @param error error vector
+    * @param residual residual vector
+    * @param ln level number
+    * @param num_sweeps number of sweeps
+    */
+   void
+   smoothErrorByWideRedBlack(
+      SAMRAIVectorReal<double>& error,
+      const SAMRAIVectorReal<double>& residual,
+      int ln,
+      int num_sweeps);
+
+   /*!
+    * @brief Chebyshev polynomial error smoothing, preconditioned by
+    * the diagonal of the operator.
+    *
+    * @param error error vector
+    * @param residual residual vector
+    * @param ln level number
+    * @param num_sweeps degree of the polynomial
+    */
+   void
+   smoothErrorByChebyshev(
+      SAMRAIVectorReal<double>& error,
+      const SAMRAIVectorReal<double>& residual,
+      int ln,
+      int num_sweeps);
+
+   /*!
+    * @brief Allocate and fill the data used by smoothErrorByWideRedBlack()
+    * that does not change between calls.
+    */
+   void
+   initializeWideSmoother(
+      const SAMRAIVectorReal<double>& solution,
+      const SAMRAIVectorReal<double>& rhs);
+
+   /*!
+    * @brief Build the private levels of the geometric multigrid
+    * coarse solver and average the Poisson coefficients onto them.
+    */
+   void
+   initializeGMGLevels();
+
+   /*!
+    * @brief Whether every box of a level and its physical domain can
+    * be coarsened by 2 without changing the region they cover.
+    *
+    * This is collective over the level's communicator.
+    */
+   bool
+   canCoarsenGMGLevel(
+      const hier::PatchLevel& level) const;
+
+   /*!
+    * @brief Get the ranks of the processes owning boxes of a level, in
+    * increasing order.
+    *
+    * This is collective over the level's communicator.
+    */
+   void
+   getGMGLevelOwners(
+      const hier::PatchLevel& level,
+      std::vector<int>& owners) const;
+
+   /*!
+    * @brief Build a copy of a level whose boxes are gathered onto fewer
+    * processes and coalesced.
+    *
+    * The processes owning boxes of the level, as given by
+    * getGMGLevelOwners(), are put in groups of group_size consecutive
+    * owners, and each group's boxes are sent to the first process of
+    * the group.
+    *
+    * This is collective over the level's communicator.
+    */
+   std::shared_ptr<hier::PatchLevel>
+   agglomerateGMGLevel(
+      const hier::PatchLevel& level,
+      const std::vector<int>& owners,
+      int group_size) const;
+
+   /*!
+    * @brief Solve the coarsest level using V-cycles of the internal
+    * geometric multigrid solver.
+    */
+   int
+   solveCoarsestLevel_GMG(
+      SAMRAIVectorReal<double>& error,
+      const SAMRAIVectorReal<double>& residual,
+      int ln);
+
+   /*!
+    * @brief Run a V-cycle on multigrid levels k and coarser.
+    *
+    * @param k Multigrid level index.  Index 0 is the coarsest level
+    *        of the solve.
+    * @param u_id Patch data index of the error on level k.
+    * @param f_id Patch data index of the right hand side on level k.
+    */
+   void
+   gmgVCycle(
+      int k,
+      int u_id,
+      int f_id);
+
+   /*!
+    * @brief Red-black smoothing on multigrid level k.
+    *
+    * @return The maximum residual seen in the last sweep.
+    */
+   double
+   gmgSmooth(
+      int k,
+      int u_id,
+      int f_id,
+      int num_sweeps,
+      double residual_tolerance);
+
+   /*!
+    * @brief Compute the residual on multigrid level k into
+    * d_gmg_residual_id.
+    *
+    * @return The local maximum residual.
+    */
+   double
+   gmgComputeResidual(
+      int k,
+      int u_id,
+      int f_id);
+
+   /*!
+    * @brief Fill the ghost cells of the error on multigrid level k
+    * with homogeneous boundary conditions.
+    */
+   void
+   gmgFillGhosts(
+      int k,
+      int u_id);
+
    /*!
     * @brief Solve the coarsest level using HYPRE
     */
@@ -559,6 +919,51 @@ private:
       pdat::SideData<double>& flux_data,
       const hier::IntVector& ratio_to_coarser) const;
 
+   /*!
+    * @brief Compute the flux on the faces of a box, which may extend
+    * into the ghost cells of the data, without any coarse-fine
+    * boundary correction.
+    *
+    * @param patch patch
+    * @param box cells whose faces get the flux
+    * @param D_id patch data index of the diffusion coefficient, used
+    *        only if it is variable
+    * @param w_data cell-centered solution data
+    * @param Dgradw_data side-centered flux data
+    */
+   void
+   computeFluxOnBox(
+      const hier::Patch& patch,
+      const hier::Box& box,
+      int D_id,
+      const pdat::CellData<double>& w_data,
+      pdat::SideData<double>& Dgradw_data) const;
+
+   /*!
+    * @brief Apply Ewing's coarse-fine flux correction on all
+    * coarse-fine faces in a box in the wide ghost region.
+    */
+   void
+   ewingFixWideFlux(
+      const hier::Patch& patch,
+      const hier::Box& box,
+      const hier::IntVector& ratio_to_coarser,
+      const pdat::CellData<double>& mask_data,
+      const pdat::CellData<double>& soln_data,
+      pdat::SideData<double>& flux_data) const;
+
+   /*!
+    * @brief Divide cell data on a patch by the diagonal of the
+    * discrete operator.
+    *
+    * The cached diagonal, which includes the physical boundary
+    * conditions, is used when the stencil is cached.
+    */
+   void
+   divideByDiagonalOnPatch(
+      const hier::Patch& patch,
+      pdat::CellData<double>& data) const;
+
    /*!
     * @brief AMR-unaware function to compute residual on a single patch,
     * with variable scalar field.
@@ -605,6 +1010,169 @@ private:
       char red_or_black,
       double* p_maxres = 0) const;
 
+   /*!
+    * @brief Red or black smoothing on a box, which may extend into the
+    * ghost cells of the data.
+    *
+    * @param patch patch
+    * @param box cells to smooth
+    * @param D_id patch data index of the diffusion coefficient, used
+    *        only if it is variable
+    * @param C_id patch data index of the scalar field, used only if
+    *        it is variable
+    * @param flux_data side-centered flux data
+    * @param rhs_data cell-centered rhs data
+    * @param soln_data cell-centered solution data
+    * @param red_or_black red-black switch.  Set to 'r' or 'b'.
+    * @param p_maxres max residual output.
+    */
+   void
+   redOrBlackSmoothingOnBox(
+      const hier::Patch& patch,
+      const hier::Box& box,
+      int D_id,
+      int C_id,
+      const pdat::SideData<double>& flux_data,
+      const pdat::CellData<double>& rhs_data,
+      pdat::CellData<double>& soln_data,
+      char red_or_black,
+      double* p_maxres) const;
+
+   /*!
+    * @brief Cells of Ewing's coarse-fine flux correction on a patch, as
+    * offsets into the solution array.
+    *
+    * The corrected flux through a coarse-fine face is the uncorrected
+    * flux computed with a substitute value of the ghost cell, which
+    * depends on the ghost cell, the interior cell across the face and
+    * the interior cell opposite it within the same coarse cell.
+    */
+   struct EwingGhostStencil {
+      std::vector<size_t> ghost;
+      std::vector<size_t> interior;
+      std::vector<size_t> opposite;
+      std::vector<double> longwt;
+      std::vector<double> tranwt;
+      //! @brief Ghost values replaced by applyEwingGhostValues().
+      std::vector<double> saved;
+   };
+
+   /*!
+    * @brief Find the cells of Ewing's correction on a patch.
+    *
+    * The stencil is left empty if the correction does not apply to
+    * the patch.
+    */
+   void
+   buildEwingGhostStencil(
+      const hier::Patch& patch,
+      const hier::IntVector& ratio_to_coarser,
+      const hier::Box& ghost_box,
+      EwingGhostStencil& stencil) const;
+
+   /*!
+    * @brief Replace the coarse-fine ghost values by those giving
+    * Ewing's corrected fluxes, saving the replaced values.
+    */
+   template<class TYPE>
+   static void
+   applyEwingGhostValues(
+      EwingGhostStencil& stencil,
+      pdat::CellData<TYPE>& soln_data);
+
+   /*!
+    * @brief Restore the ghost values replaced by
+    * applyEwingGhostValues().
+    */
+   template<class TYPE>
+   static void
+   restoreEwingGhostValues(
+      const EwingGhostStencil& stencil,
+      pdat::CellData<TYPE>& soln_data);
+
+   /*!
+    * @brief The single precision FAC cycle on level ln and the levels
+    * down to coarse_ln.
+    *
+    * Expects the single precision correction to be zero and the
+    * single precision residual to be set on level ln.
+    */
+   void
+   reducedPrecisionCycleOnLevel(
+      SAMRAIVectorReal<double>& error,
+      SAMRAIVectorReal<double>& residual,
+      int ln,
+      int coarse_ln,
+      int num_pre_sweeps,
+      int num_post_sweeps);
+
+   /*!
+    * @brief Red-black sweeps on the single precision correction of a
+    * level, with the coarse-fine ghost values filled once from the
+    * next coarser level.
+    */
+   void
+   smoothReducedPrecisionError(
+      int ln,
+      int num_sweeps);
+
+   /*!
+    * @brief Residual of the single precision error equation on a
+    * level, stored in the single precision scratch data.
+    */
+   void
+   computeReducedPrecisionResidualOnLevel(
+      int ln);
+
+   /*!
+    * @brief One pass of a red-black sweep on a patch with the C++
+    * kernels.
+    *
+    * Pass 0 updates the red cells and the black cells not next to a
+    * ghost cell.  Pass 1 updates the other black cells.
+    *
+    * @return the maximum residual before the update
+    */
+   double
+   redBlackPassOnPatch(
+      const hier::Patch& patch,
+      const pdat::CellData<double>& rhs_data,
+      pdat::CellData<double>& soln_data,
+      EwingGhostStencil& ewing_stencil,
+      int pass,
+      bool thread_within_patch) const;
+
+   /*!
+    * @brief Compute the flux, including Ewing's correction, on the
+    * patches of a level with the C++ kernels, and optionally the
+    * residual in the same pass.
+    */
+   void
+   computeFluxAndResidualOnLevel(
+      const hier::PatchLevel& level,
+      const SAMRAIVectorReal<double>& solution,
+      const SAMRAIVectorReal<double>& rhs,
+      SAMRAIVectorReal<double>& residual,
+      int flux_id,
+      bool compute_residual) const;
+
+   /*!
+    * @brief Build the cached stencil on all levels of the solve.
+    *
+    * The face coefficients and the D part of the diagonal are
+    * computed from D and the physical boundary conditions, then
+    * updateStencilC() adds C.
+    */
+   void
+   computeStencil();
+
+   /*!
+    * @brief Recompute the diagonal of the cached stencil from its D
+    * part and the current C, and its single precision copy if any.
+    */
+   void
+   updateStencilC();
+
    //@}
 
    //@{ @name For executing, caching and resetting communication schedules.
@@ -894,6 +1462,128 @@ private:
    std::shared_ptr<CellPoissonHypreSolver> d_hypre_solver;
 #endif
 
+   //@{ @name Geometric multigrid coarse solver
+
+   /*!
+    * @brief Red-black sweeps before and after each coarse-grid
+    * correction.
+    */
+   int d_gmg_num_sweeps;
+
+   /*!
+    * @brief Maximum number of grid resolutions.
+    */
+   int d_gmg_max_levels;
+
+   /*!
+    * @brief Average cells per owning process below which a level is
+    * agglomerated.
+    */
+   int d_gmg_agglomeration_threshold;
+
+   /*!
+    * @brief Maximum red-black sweeps on the coarsest multigrid level.
+    */
+   int d_gmg_bottom_max_sweeps;
+
+   /*!
+    * @brief Multigrid levels, finest first.
+    *
+    * d_gmg_levels[0] is the coarsest level of the solve.  The others
+    * are private levels built by initializeGMGLevels().
+    */
+   std::vector<std::shared_ptr<hier::PatchLevel> > d_gmg_levels;
+
+   /*!
+    * @brief Whether d_gmg_levels[k+1] is a redistributed copy of
+    * d_gmg_levels[k] rather than a coarsened one.
+    */
+   std::vector<bool> d_gmg_redistributed;
+
+   //! @brief Prolongation of corrections between multigrid levels.
+   std::shared_ptr<hier::RefineOperator> d_gmg_prolongation_operator;
+
+   //! @brief Ghost filling of the error on multigrid levels.
+   std::shared_ptr<xfer::RefineAlgorithm> d_gmg_ghostfill_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_gmg_ghostfill_schedules;
+
+   /*!
+    * @brief Copies of the residual onto redistributed levels, where it
+    * becomes the right hand side.
+    *
+    * Entry k moves data from d_gmg_levels[k] to d_gmg_levels[k+1].
+    */
+   std::shared_ptr<xfer::RefineAlgorithm> d_gmg_rhs_redistribute_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_gmg_rhs_redistribute_schedules;
+
+   /*!
+    * @brief Copies of the correction back from redistributed levels.
+    *
+    * Entry k moves data from d_gmg_levels[k+1] to d_gmg_levels[k].
+    */
+   std::shared_ptr<xfer::RefineAlgorithm> d_gmg_error_redistribute_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_gmg_error_redistribute_schedules;
+
+   //@}
+
+   //@{ @name Smoothers
+
+   /*!
+    * @brief Smoother used by smoothError().
+    */
+   std::string d_smoothing_choice;
+
+   /*!
+    * @brief Red-black sweeps done per ghost exchange.
+    */
+   int d_smoothing_sweeps_per_ghost_fill;
+
+   /*!
+    * @brief Ratio of the largest to the smallest eigenvalue damped by
+    * the Chebyshev smoother.
+    */
+   double d_chebyshev_eigenvalue_ratio;
+
+   /*!
+    * @brief Kernels of the ordinary red-black sweeps and of the
+    * residual, "fortran" or "cxx".
+    */
+   std::string d_smoothing_kernel;
+
+   /*!
+    * @brief Precision of the FAC cycles, "double" or "float".
+    */
+   std::string d_smoothing_precision;
+
+   /*!
+    * @brief Filling of the wide error from the error and, except on
+    * the coarsest level of the solve, the next coarser level.
+    */
+   std::shared_ptr<xfer::RefineAlgorithm> d_wide_ghostfill_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_wide_ghostfill_schedules;
+
+   //! @brief Filling of the wide error from the error on the same level.
+   std::shared_ptr<xfer::RefineAlgorithm>
+   d_wide_ghostfill_nocoarse_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_wide_ghostfill_nocoarse_schedules;
+
+   //! @brief Exchange of the wide error between sweeps.
+   std::shared_ptr<xfer::RefineAlgorithm> d_wide_exchange_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_wide_exchange_schedules;
+
+   //! @brief Filling of the wide right hand side from the residual.
+   std::shared_ptr<xfer::RefineAlgorithm> d_wide_rhs_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_wide_rhs_schedules;
+
+   //@}
+
    /*!
     * @brief Externally provided physical boundary condition object.
     *
@@ -914,6 +1604,54 @@ private:
    static std::shared_ptr<pdat::OutersideVariable<double> >
    s_oflux_scratch_var[SAMRAI::MAX_DIM_VAL];
 
+   static std::shared_ptr<pdat::CellVariable<double> >
+   s_gmg_rhs_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<double> >
+   s_gmg_residual_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<double> >
+   s_wide_error_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<double> >
+   s_wide_rhs_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::SideVariable<double> >
+   s_wide_diffcoef_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<double> >
+   s_wide_scalar_field_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<double> >
+   s_wide_mask_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<double> >
+   s_smoother_residual_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<double> >
+   s_smoother_direction_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<double> >
+   s_stencil_diagonal_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::SideVariable<double> >
+   s_stencil_offdiagonal_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<float> >
+   s_stencil_float_diagonal_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::SideVariable<float> >
+   s_stencil_float_offdiagonal_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<float> >
+   s_float_error_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<float> >
+   s_float_residual_var[SAMRAI::MAX_DIM_VAL];
+
+   static std::shared_ptr<pdat::CellVariable<float> >
+   s_float_scratch_var[SAMRAI::MAX_DIM_VAL];
+
    /*!
     * @brief Default context of internally maintained hierarchy data.
     */
@@ -951,6 +1689,98 @@ private:
     */
    int d_oflux_scratch_id;
 
+   /*!
+    * @brief ID of the right hand side on the private multigrid levels.
+    *
+    * Set in constructor and never changed.
+    * Corresponds to a pdat::CellVariable<double> named
+    * @c d_object_name+"::gmg_rhs".
+    */
+   int d_gmg_rhs_id;
+
+   /*!
+    * @brief ID of the residual on the multigrid levels.
+    *
+    * Set in constructor and never changed.
+    * Corresponds to a pdat::CellVariable<double> named
+    * @c d_object_name+"::gmg_residual".
+    * It also holds prolonged corrections before they are added
+    * to the error.
+    */
+   int d_gmg_residual_id;
+
+   /*!
+    * @brief IDs of the wide data of smoothErrorByWideRedBlack().
+    *
+    * Registered in the constructor when
+    * d_smoothing_sweeps_per_ghost_fill > 1, and -1 otherwise.
+    * With k sweeps per ghost fill, the error and mask have 2k ghost
+    * cells and the others 2k-1.  The mask is 1 on cells covered by a
+    * patch of the level, -1 outside the physical domain and 0 on
+    * coarse-fine ghost cells.
+    */
+   int d_wide_error_id;
+   int d_wide_rhs_id;
+   int d_wide_diffcoef_id;
+   int d_wide_scalar_field_id;
+   int d_wide_mask_id;
+
+   /*!
+    * @brief IDs of the residual and update direction of
+    * smoothErrorByChebyshev().
+    *
+    * Set in constructor and never changed.
+    */
+   int d_smoother_residual_id;
+   int d_smoother_direction_id;
+
+   /*!
+    * @brief IDs of the cached stencil.
+    *
+    * Set in constructor and never changed.  The diagonal has depth 2:
+    * the diagonal of the operator and its part coming from D.  The
+    * off-diagonal holds D/h^2 on each face, and zero on the physical
+    * boundary faces, whose coupling is folded into the diagonal.
+    * Allocated on the levels of the solve when d_stencil_is_cached.
+    */
+   int d_stencil_diagonal_id;
+   int d_stencil_offdiagonal_id;
+
+   /*!
+    * @brief IDs of the single precision copy of the cached stencil
+    * read by the red-black sweeps.
+    *
+    * Registered in the constructor when d_smoothing_precision is
+    * "float", and -1 otherwise.  The diagonal has depth 1.
+    */
+   int d_stencil_float_diagonal_id;
+   int d_stencil_float_offdiagonal_id;
+
+   /*!
+    * @brief IDs of the single precision data of the reduced precision
+    * cycle: the correction (one ghost cell), the residual it solves
+    * for, and the scratch data of the prolongation and of the
+    * restricted residual.
+    *
+    * Registered in the constructor when d_smoothing_precision is
+    * "float", and -1 otherwise.  Allocated on the levels of the solve
+    * with the cached stencil.
+    */
+   int d_float_error_id;
+   int d_float_residual_id;
+   int d_float_scratch_id;
+
+   /*!
+    * @brief Whether the stencil is cached for the current solve.
+    */
+   bool d_stencil_is_cached;
+
+   /*!
+    * @brief Variable passed to the physical bc coefficient object
+    * when the stencil is built.
+    */
+   std::shared_ptr<hier::Variable> d_stencil_bc_variable;
+
    //@}
 
    //@{
@@ -996,6 +1826,29 @@ private:
    std::vector<std::shared_ptr<xfer::RefineSchedule> >
    d_ghostfill_nocoarse_refine_schedules;
 
+   /*!
+    * @brief Transfers of the single precision data of the reduced
+    * precision cycle: prolongation of the correction, restriction of
+    * the residual, and ghost filling of the correction with and
+    * without the next coarser level.  No physical boundary values
+    * are set, because the stencil does not read them.
+    */
+   std::shared_ptr<xfer::RefineAlgorithm>
+   d_float_prolongation_refine_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_float_prolongation_refine_schedules;
+   std::shared_ptr<xfer::CoarsenAlgorithm>
+   d_float_rrestriction_coarsen_algorithm;
+   std::vector<std::shared_ptr<xfer::CoarsenSchedule> >
+   d_float_rrestriction_coarsen_schedules;
+   std::shared_ptr<xfer::RefineAlgorithm> d_float_ghostfill_refine_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_float_ghostfill_refine_schedules;
+   std::shared_ptr<xfer::RefineAlgorithm>
+   d_float_ghostfill_nocoarse_refine_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_float_ghostfill_nocoarse_refine_schedules;
+
    //@}
 
    /*!
@@ -1056,10 +1909,18 @@ private:
    std::shared_ptr<tbox::Timer> t_prolong;
    std::shared_ptr<tbox::Timer> t_smooth_error;
    std::shared_ptr<tbox::Timer> t_solve_coarsest;
+   std::shared_ptr<tbox::Timer> t_gmg_setup;
    std::shared_ptr<tbox::Timer> t_compute_composite_residual;
    std::shared_ptr<tbox::Timer> t_compute_residual_norm;
 
    static tbox::StartupShutdownManager::Handler s_finalize_handler;
+
+   /*!
+    * @brief MPI tags for moving boxes to the group leaders in
+    * agglomerateGMGLevel().
+    */
+   static const int CellPoissonFACOps_GMGAGGLOMERATE0 = 5;
+   static const int CellPoissonFACOps_GMGAGGLOMERATE1 = 6;
 };
 
 }
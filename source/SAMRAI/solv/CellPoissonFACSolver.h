@@ -12,6 +12,7 @@
 
 #include "SAMRAI/SAMRAI_config.h"
 
+#include "SAMRAI/solv/FACKrylovSolver.h"
 #include "SAMRAI/solv/FACPreconditioner.h"
 #include "SAMRAI/solv/CellPoissonFACOps.h"
 #include "SAMRAI/solv/PoissonSpecifications.h"
@@ -93,6 +94,11 @@ namespace solv {
  *    - \b    enable_logging
  *       turn logging on or off
  *
+ *    - \b    krylov_solver
+ *       if present, solve with a FACKrylovSolver built from this
+ *       database, using the FAC preconditioner as its preconditioner,
+ *       instead of iterating FAC cycles alone
+ *
  * <b> Details: </b> <br>
  * <table>
  *   <tr>
@@ -111,6 +117,14 @@ namespace solv {
  *     <td>opt</td>
  *     <td>Not written to restart.  Value in input db used.</td>
  *   </tr>
+ *   <tr>
+ *     <td>krylov_solver</td>
+ *     <td>Database</td>
+ *     <td>none</td>
+ *     <td>see FACKrylovSolver</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
  * </table>
  *
  */
@@ -429,7 +443,23 @@ public:
    int
    getNumberOfIterations() const
    {
-      return d_fac_precond->getNumberOfIterations();
+      return d_krylov_solver ?
+             d_krylov_solver->getNumberOfIterations() :
+             d_fac_precond->getNumberOfIterations();
+   }
+
+   /*!
+    * @brief Return the number of FAC cycles of the last (or current)
+    * FAC iteration process done in single precision.
+    *
+    * Nonzero only with smoothing_precision = "float" in the input of
+    * CellPoissonFACOps, and zero when a Krylov solver is used.
+    */
+   int
+   getNumberOfReducedPrecisionCycles() const
+   {
+      return d_krylov_solver ?
+             0 : d_fac_precond->getNumberOfReducedPrecisionCycles();
    }
 
    /*!
@@ -444,7 +474,11 @@ public:
       double& avg_factor,
       double& final_factor) const
    {
-      d_fac_precond->getConvergenceFactors(avg_factor, final_factor);
+      if (d_krylov_solver) {
+         d_krylov_solver->getConvergenceFactors(avg_factor, final_factor);
+      } else {
+         d_fac_precond->getConvergenceFactors(avg_factor, final_factor);
+      }
    }
 
    /*!
@@ -459,7 +493,9 @@ public:
    double
    getResidualNorm() const
    {
-      return d_fac_precond->getResidualNorm();
+      return d_krylov_solver ?
+             d_krylov_solver->getResidualNorm() :
+             d_fac_precond->getResidualNorm();
    }
 
    //@}
@@ -537,6 +573,11 @@ private:
     */
    std::shared_ptr<FACPreconditioner> d_fac_precond;
 
+   /*!
+    * @brief Krylov accelerator using d_fac_precond, if requested in input.
+    */
+   std::shared_ptr<FACKrylovSolver> d_krylov_solver;
+
    /*!
     * @brief Robin bc object in use.
     */
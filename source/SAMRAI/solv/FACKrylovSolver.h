@@ -0,0 +1,454 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2019 Lawrence Livermore National Security, LLC
+ * Description:   Pipelined Krylov solvers preconditioned by FAC
+ *
+ ************************************************************************/
+
+#ifndef included_solv_FACKrylovSolver
+#define included_solv_FACKrylovSolver
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/math/HierarchyDataOpsReal.h"
+#include "SAMRAI/solv/FACOperatorStrategy.h"
+#include "SAMRAI/solv/FACPreconditioner.h"
+#include "SAMRAI/solv/SAMRAIVectorReal.h"
+#include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/Timer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SAMRAI {
+namespace solv {
+
+/*!
+ * @brief Native Krylov solver for Au=f on a range of hierarchy levels,
+ * preconditioned by one FAC cycle per iteration.
+ *
+ * The composite grid operator A is the one defined by the
+ * FACOperatorStrategy object also used by the FACPreconditioner.
+ * Its action on a vector is computed as the negative of the composite
+ * residual of the homogeneous problem, so no additional operator
+ * implementation is needed.  The preconditioner is
+ * FACPreconditioner::applyCycle().
+ *
+ * Two methods are available:
+ * - "cg": pipelined preconditioned conjugate gradients (Ghysels and
+ *   Vanroose).  This requires that both A and the FAC cycle be
+ *   symmetric, which for the usual smoothers means using the same
+ *   number of pre- and postsmoothing sweeps.
+ * - "gmres": restarted, right-preconditioned pipelined GMRES with a
+ *   lag of one (p(1)-GMRES of Ghysels, Ashby, Meerbergen and
+ *   Vanroose).  It makes no symmetry assumption.
+ *
+ * Both methods gather all of the inner products of an iteration into
+ * a single non-blocking reduction, which is started before the
+ * preconditioner and operator are applied and completed after, so
+ * the global reduction latency is hidden behind the FAC cycle.
+ * Iterations are otherwise communication-free except for the ghost
+ * exchanges done by the operator.
+ *
+ * Inner products are those of SAMRAIVectorReal, so the solution vector
+ * should carry control volumes that mask out covered coarse cells, as
+ * the vectors built by CellPoissonFACSolver do.  Residual norms are
+ * reported in the norm of FACOperatorStrategy::computeResidualNorm(),
+ * so the tolerances have the same meaning as for FACPreconditioner.
+ * The pipelined recurrences do not update the true residual, so
+ * convergence is confirmed with an explicitly computed residual
+ * before returning.
+ *
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *    - \b    krylov_method
+ *       "cg" or "gmres"
+ *
+ *    - \b    max_iterations
+ *       maximum number of Krylov iterations (preconditioner applications)
+ *
+ *    - \b    residual_tol
+ *
+ *    - \b    relative_residual_tol
+ *
+ *    - \b    gmres_restart
+ *       number of GMRES iterations between restarts
+ *
+ *    - \b    gmres_shift
+ *       shift s of the pipelined GMRES basis, which is built from
+ *       (AM^{-1}-sI) for accuracy; 1 suits a good preconditioner
+ *
+ *    - \b    enable_logging
+ *       log the residual norm of each iteration
+ *
+ * <b> Details:</b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>krylov_method</td>
+ *     <td>string</td>
+ *     <td>"gmres"</td>
+ *     <td>"cg", "gmres"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>max_iterations</td>
+ *     <td>int</td>
+ *     <td>50</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>residual_tol</td>
+ *     <td>double</td>
+ *     <td>1.0e-6</td>
+ *     <td>>0.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>relative_residual_tol</td>
+ *     <td>double</td>
+ *     <td>-1.0</td>
+ *     <td>-1.0 or >0.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>gmres_restart</td>
+ *     <td>int</td>
+ *     <td>20</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>gmres_shift</td>
+ *     <td>double</td>
+ *     <td>1.0</td>
+ *     <td>any double</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>enable_logging</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ * </table>
+ *
+ * @see FACPreconditioner
+ */
+
+class FACKrylovSolver
+{
+public:
+   /*!
+    * Constructor.
+    *
+    * @param name Object name
+    * @param fac_precond FAC preconditioner, which must use fac_ops
+    * @param fac_ops FAC operator defining A
+    * @param input_db Input database with initialization parameters
+    *
+    * @pre fac_precond
+    * @pre fac_ops
+    */
+   FACKrylovSolver(
+      const std::string& name,
+      const std::shared_ptr<FACPreconditioner>& fac_precond,
+      const std::shared_ptr<FACOperatorStrategy>& fac_ops,
+      const std::shared_ptr<tbox::Database>& input_db =
+         std::shared_ptr<tbox::Database>());
+
+   /*!
+    * Virtual destructor.
+    */
+   virtual ~FACKrylovSolver();
+
+   /*!
+    * @brief Solve linear system Au=f.
+    *
+    * The vector requirements are those of
+    * FACPreconditioner::solveSystem().  If the solver state is not
+    * initialized, it is initialized before and deallocated after the
+    * solve.
+    *
+    * @param solution solution vector u, holding the initial guess
+    * @param rhs right hand side vector f
+    *
+    * @return whether solver converged to specified level
+    */
+   bool
+   solveSystem(
+      SAMRAIVectorReal<double>& solution,
+      SAMRAIVectorReal<double>& rhs);
+
+   /*!
+    * @brief Compute hierarchy-dependent data required for solving.
+    *
+    * This also initializes the state of the FAC preconditioner.
+    *
+    * @param solution solution vector u
+    * @param rhs right hand side vector f
+    */
+   void
+   initializeSolverState(
+      const SAMRAIVectorReal<double>& solution,
+      const SAMRAIVectorReal<double>& rhs);
+
+   /*!
+    * @brief Remove all hierarchy-dependent data computed by
+    * initializeSolverState(), including that of the FAC preconditioner.
+    */
+   void
+   deallocateSolverState();
+
+   /*!
+    * @brief Return the number of Krylov iterations of the last solve.
+    */
+   int
+   getNumberOfIterations() const
+   {
+      return d_number_iterations;
+   }
+
+   /*!
+    * @brief Return the average and final convergence factors of the
+    * last solve.
+    *
+    * The final factor is the reduction of the residual norm over the
+    * last iteration.
+    */
+   void
+   getConvergenceFactors(
+      double& avg_factor,
+      double& final_factor) const;
+
+   /*!
+    * @brief Return the residual norm at the end of the last solve.
+    */
+   double
+   getResidualNorm() const
+   {
+      return d_residual_norm;
+   }
+
+   /*!
+    * @brief Return the name of this object.
+    */
+   const std::string&
+   getObjectName() const
+   {
+      return d_object_name;
+   }
+
+private:
+   // The following are not implemented:
+   FACKrylovSolver(
+      const FACKrylovSolver&);
+   FACKrylovSolver&
+   operator = (
+      const FACKrylovSolver&);
+
+   /*!
+    * @brief Read input parameters from the input database.
+    */
+   void
+   getFromInput(
+      const std::shared_ptr<tbox::Database>& input_db);
+
+   /*!
+    * @brief Compute the composite residual r=f-Au over all levels
+    * and return its norm as measured by the FAC operator.
+    */
+   double
+   computeFullCompositeResidual(
+      SAMRAIVectorReal<double>& residual,
+      SAMRAIVectorReal<double>& solution,
+      SAMRAIVectorReal<double>& rhs);
+
+   /*!
+    * @brief Set y=Ax for the operator with homogeneous boundary
+    * conditions.
+    *
+    * Covered parts of x are overwritten by restriction of the finer
+    * levels.
+    */
+   void
+   applyOperator(
+      const std::shared_ptr<SAMRAIVectorReal<double> >& y,
+      const std::shared_ptr<SAMRAIVectorReal<double> >& x);
+
+   /*!
+    * @brief Set z to one FAC cycle applied to r.
+    */
+   void
+   applyPreconditioner(
+      const std::shared_ptr<SAMRAIVectorReal<double> >& z,
+      const std::shared_ptr<SAMRAIVectorReal<double> >& r);
+
+   /*!
+    * @brief Start the global sum of the first count entries of
+    * d_local_dots into d_global_dots.
+    */
+   void
+   startReduction(
+      int count);
+
+   /*!
+    * @brief Wait for the reduction started by startReduction().
+    */
+   void
+   finishReduction();
+
+   /*!
+    * @brief Solve Ae=r for the correction e with pipelined CG.
+    *
+    * @return whether the recurrence residual reached the tolerance
+    */
+   bool
+   solveByPipelinedCG(
+      double tolerance);
+
+   /*!
+    * @brief Solve Ae=r for the correction e with restarted
+    * pipelined GMRES.
+    *
+    * @return whether the residual reached the tolerance
+    */
+   bool
+   solveByPipelinedGMRES(
+      double tolerance);
+
+   /*!
+    * @brief Record the residual norm of one iteration.
+    *
+    * With new_iteration false, residual_norm replaces the norm of the
+    * last iteration, as when GMRES computes the true residual at a
+    * restart, and the norm before that iteration is kept for the final
+    * convergence factor.
+    */
+   void
+   logIteration(
+      double residual_norm,
+      bool new_iteration = true);
+
+   std::string d_object_name;
+
+   std::shared_ptr<FACPreconditioner> d_fac_precond;
+
+   std::shared_ptr<FACOperatorStrategy> d_fac_operator;
+
+   //@{
+   /*!
+    * @name Parameters from input.
+    */
+   std::string d_krylov_method;
+   int d_max_iterations;
+   double d_residual_tolerance;
+   double d_relative_residual_tolerance;
+   int d_gmres_restart;
+   double d_gmres_shift;
+   bool d_enable_logging;
+   //@}
+
+   //@{
+   /*!
+    * @name Solution vector-dependent data.
+    *
+    * These are set by initializeSolverState and deallocateSolverState.
+    */
+   std::shared_ptr<hier::PatchHierarchy> d_patch_hierarchy;
+   int d_coarsest_ln;
+   int d_finest_ln;
+
+   /*!
+    * @brief Correction to the solution, the unknown of the Krylov
+    * iteration.
+    */
+   std::shared_ptr<SAMRAIVectorReal<double> > d_error_vector;
+
+   /*!
+    * @brief Residual of the initial guess, the right hand side of
+    * the Krylov iteration.
+    */
+   std::shared_ptr<SAMRAIVectorReal<double> > d_residual_vector;
+
+   /*!
+    * @brief Zero right hand side for computing the operator action.
+    */
+   std::shared_ptr<SAMRAIVectorReal<double> > d_zero_vector;
+
+   /*!
+    * @brief Work vectors.  For CG these are the recurrence vectors.
+    * For GMRES they are the Arnoldi basis followed by two scratch vectors.
+    */
+   std::vector<std::shared_ptr<SAMRAIVectorReal<double> > > d_work_vectors;
+
+   /*!
+    * @brief Images of the GMRES basis under the preconditioned operator.
+    */
+   std::vector<std::shared_ptr<SAMRAIVectorReal<double> > > d_image_vectors;
+
+   /*!
+    * @brief Objects facilitating operations over a specific range
+    * of levels.
+    */
+   std::vector<std::shared_ptr<math::HierarchyDataOpsReal<double> > >
+   d_controlled_level_ops;
+   //@}
+
+   //@{
+   /*!
+    * @name Fused reduction state.
+    */
+   tbox::SAMRAI_MPI d_mpi;
+   std::vector<double> d_local_dots;
+   std::vector<double> d_global_dots;
+   tbox::SAMRAI_MPI::Request d_reduction_request;
+   bool d_reduction_pending;
+   //@}
+
+   //@{
+   /*!
+    * @name Status of last solve.
+    */
+   int d_number_iterations;
+   double d_residual_norm;
+   double d_initial_residual_norm;
+   double d_previous_residual_norm;
+
+   /*!
+    * @brief Ratio of the FAC operator's residual norm to the vector
+    * 2-norm, for converting recurrence residuals.
+    */
+   double d_norm_scale;
+   //@}
+
+   std::shared_ptr<tbox::Timer> t_solve_system;
+   std::shared_ptr<tbox::Timer> t_reduction_wait;
+};
+
+}
+}
+
+#endif
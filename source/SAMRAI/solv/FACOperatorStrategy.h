@@ -363,6 +363,45 @@ public:
    virtual void
    deallocateOperatorState();
 
+   /*!
+    * @brief Whether FAC cycles should be done by
+    * applyReducedPrecisionCycle().
+    *
+    * The default implementation returns false.
+    */
+   virtual bool
+   hasReducedPrecisionCycle() const;
+
+   /*!
+    * @brief Approximately solve the error equation Ae=r with one FAC
+    * cycle done in a precision lower than that of the vectors.
+    *
+    * The operator converts the residual to its own data, does the
+    * cycle there and converts the correction back into the error.
+    * The caller adds the error to the solution and recomputes the
+    * residual in full precision, so the reduced precision only
+    * limits how much one cycle reduces the residual.
+    *
+    * The residual below the finer levels may be overwritten.
+    * Called only if hasReducedPrecisionCycle() returns true.
+    * The default implementation is an error.
+    *
+    * @param error error vector, set to the correction
+    * @param residual residual vector
+    * @param fine_ln finest level number
+    * @param coarse_ln coarsest level number
+    * @param num_pre_sweeps number of presmoothing sweeps
+    * @param num_post_sweeps number of postsmoothing sweeps
+    */
+   virtual void
+   applyReducedPrecisionCycle(
+      SAMRAIVectorReal<double>& error,
+      SAMRAIVectorReal<double>& residual,
+      int fine_ln,
+      int coarse_ln,
+      int num_pre_sweeps,
+      int num_post_sweeps);
+
    //@}
 
 };
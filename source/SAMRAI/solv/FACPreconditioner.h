@@ -38,6 +38,16 @@ namespace solv {
  * maximum number of iterations is reached, or the residual norm on
  * all levels is below the given tolerance.
  *
+ * Each cycle solves for the error from the residual of the current
+ * solution, recomputed in full after the correction is added, so the
+ * iteration is an iterative refinement.  If the operator has a
+ * reduced precision cycle (FACOperatorStrategy::hasReducedPrecisionCycle()),
+ * solveSystem() lets it do the whole cycle in that precision and
+ * keeps only the correction, the residual and the stopping test in
+ * double precision.  The rounding errors of the cycle are corrected
+ * by later cycles, so the solution still converges to the double
+ * precision tolerance.
+ *
  * The user must perform the following steps to use the FAC solver:
  * -# Create a FACPreconditioner, providing a valid concrete
  *    FACOperatorStrategy object.
@@ -191,6 +201,29 @@ public:
       SAMRAIVectorReal<double>& solution,
       SAMRAIVectorReal<double>& rhs);
 
+   /*!
+    * @brief Apply one FAC cycle to the error equation Ae=r.
+    *
+    * The cycle starts from e=0 and uses the homogeneous boundary
+    * conditions of the error equation, so it is a fixed linear
+    * operator applied to r.  This is the action of FAC as a
+    * preconditioner for a Krylov method such as FACKrylovSolver.
+    * The residual vector is not modified.
+    *
+    * The solver state must have been initialized with
+    * initializeSolverState(), and both vectors must be compatible with
+    * that state.  Ghost cells of the error vector are overwritten.
+    *
+    * @param error error vector e, set to the result of the cycle
+    * @param residual residual vector r
+    *
+    * @pre d_patch_hierarchy
+    */
+   void
+   applyCycle(
+      SAMRAIVectorReal<double>& error,
+      const SAMRAIVectorReal<double>& residual);
+
    /*!
     * @brief Compute hierarchy-dependent data required for solving
     *
@@ -331,6 +364,18 @@ public:
       return d_number_iterations;
    }
 
+   /*!
+    * @brief Return the number of cycles of the last (or current)
+    * solveSystem() done by the operator's reduced precision cycle.
+    *
+    * @see FACOperatorStrategy::applyReducedPrecisionCycle()
+    */
+   int
+   getNumberOfReducedPrecisionCycles() const
+   {
+      return d_number_reduced_precision_cycles;
+   }
+
    /*!
     * @brief Get convergance rates of
     * the last (or current if there is one) FAC solve.
@@ -662,6 +707,7 @@ private:
     * @name Status quantitities for FAC iteration.
     */
    int d_number_iterations;
+   int d_number_reduced_precision_cycles;
    double d_residual_norm;
 
    /*!
@@ -0,0 +1,122 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2019 Lawrence Livermore National Security, LLC
+ * Description:   Interface to user functions for the native Newton-Krylov solver
+ *
+ ************************************************************************/
+
+#ifndef included_solv_NewtonKrylovAbstractFunctions
+#define included_solv_NewtonKrylovAbstractFunctions
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/solv/SAMRAIVectorReal.h"
+
+#include <memory>
+
+namespace SAMRAI {
+namespace solv {
+
+/*!
+ * @brief Abstract base class that declares the functions used by the
+ * NewtonKrylovSolver.
+ *
+ * To provide these functions to the solver, a subclass of this base
+ * class must be instantiated and be supplied to the NewtonKrylovSolver
+ * constructor.  The vectors passed to these functions are clones of
+ * the solution vector given to NewtonKrylovSolver::initialize(), so
+ * unlike with the PETSc and SUNDIALS interfaces no unwrapping is
+ * needed.  Each function returns 0 if successful.
+ *
+ * @see NewtonKrylovSolver
+ */
+
+class NewtonKrylovAbstractFunctions
+{
+public:
+   /*!
+    * Uninteresting constructor for NewtonKrylovAbstractFunctions.
+    */
+   NewtonKrylovAbstractFunctions();
+
+   /*!
+    * Uninteresting destructor for NewtonKrylovAbstractFunctions.
+    */
+   virtual ~NewtonKrylovAbstractFunctions();
+
+   /*!
+    * User-supplied nonlinear function evaluation.
+    *
+    * @param xcur (IN) the current iterate for the nonlinear system
+    * @param fcur (OUT) current function value
+    *
+    * IMPORTANT: This function must not modify xcur, except for its
+    * ghost cells.
+    */
+   virtual int
+   evaluateNonlinearFunction(
+      const std::shared_ptr<SAMRAIVectorReal<double> >& xcur,
+      const std::shared_ptr<SAMRAIVectorReal<double> >& fcur) = 0;
+
+   /*!
+    * Optional user-supplied routine to evaluate the Jacobian of the
+    * system.  This function can be empty if the Jacobian-free option
+    * is used.
+    *
+    * @param x (IN) current Newton iterate.
+    *
+    * IMPORTANT: This function must not modify x.
+    */
+   virtual int
+   evaluateJacobian(
+      const std::shared_ptr<SAMRAIVectorReal<double> >& x) = 0;
+
+   /*!
+    * Optional user-supplied Jacobian-vector product routine.  This
+    * function can be empty if the Jacobian-free option is used.
+    *
+    * @param x (IN) vector to be multiplied by the Jacobian.
+    * @param y (OUT) the product of the Jacobian and vector
+    *
+    * IMPORTANT: This function must not modify x, except for its ghost
+    * cells.
+    */
+   virtual int
+   jacobianTimesVector(
+      const std::shared_ptr<SAMRAIVectorReal<double> >& x,
+      const std::shared_ptr<SAMRAIVectorReal<double> >& y) = 0;
+
+   /*!
+    * User-supplied preconditioner setup function, called once per
+    * Newton iteration before any call to applyPreconditioner().
+    *
+    * @param xcur (IN) current Newton iterate.
+    */
+   virtual int
+   setupPreconditioner(
+      const std::shared_ptr<SAMRAIVectorReal<double> >& xcur) = 0;
+
+   /*!
+    * User-supplied preconditioner solve function.  This function must
+    * approximately solve \f$J z = r\f$.  It is used as a right
+    * preconditioner, and it may be an inexact iterative solve, since
+    * the Krylov method is flexible GMRES.
+    *
+    * @param r (IN) right-hand side of preconditioning system
+    * @param z (OUT) result of applying preconditioner to right-hand side
+    *
+    * IMPORTANT: This function must not modify r.
+    */
+   virtual int
+   applyPreconditioner(
+      const std::shared_ptr<SAMRAIVectorReal<double> >& r,
+      const std::shared_ptr<SAMRAIVectorReal<double> >& z) = 0;
+};
+
+}
+}
+
+#endif
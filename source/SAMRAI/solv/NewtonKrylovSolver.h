@@ -0,0 +1,530 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2019 Lawrence Livermore National Security, LLC
+ * Description:   Native Jacobian-free Newton-Krylov nonlinear solver
+ *
+ ************************************************************************/
+
+#ifndef included_solv_NewtonKrylovSolver
+#define included_solv_NewtonKrylovSolver
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/solv/NewtonKrylovAbstractFunctions.h"
+#include "SAMRAI/solv/NonlinearSolverStrategy.h"
+#include "SAMRAI/solv/SAMRAIVectorReal.h"
+#include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/Timer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SAMRAI {
+namespace solv {
+
+/*!
+ * @brief Inexact Newton solver for F(x)=0 that works directly on
+ * SAMRAIVectorReal, without PETSc or SUNDIALS.
+ *
+ * Each Newton step solves J(x) dx = -F(x) with restarted, right
+ * preconditioned flexible GMRES to the relative tolerance eta (the
+ * forcing term).  By default the product of the Jacobian with a
+ * vector v is approximated by the finite difference
+ * (F(x+hv)-F(x))/h with
+ * h = function_evaluation_error*sqrt(1+||x||)/||v||, so only
+ * F and the preconditioner are needed.  The forcing term is constant
+ * or chosen by one of the two rules of Eisenstat and Walker.  The
+ * step is globalized by a backtracking line search on ||F|| with
+ * the sufficient decrease condition of Eisenstat and Walker,
+ * ||F(x+lambda dx)|| <= (1-t lambda (1-eta))||F(x)||, using
+ * t = 1e-4 and a safeguarded quadratic model of ||F||^2 to choose
+ * each reduction of lambda.
+ *
+ * The vectors are clones of the solution vector, operated on through
+ * SAMRAIVectorReal and the hierarchy data operations without further
+ * wrapping.  GMRES orthogonalizes by classical Gram-Schmidt with one
+ * reorthogonalization, computing the local inner products of each
+ * pass together and summing them in a single global reduction, so
+ * orthogonalization costs two reductions per iteration regardless of
+ * the basis size.
+ * Norms are 2-norms in the inner product of SAMRAIVectorReal, which
+ * are weighted if the solution vector has control volumes.
+ *
+ * solve() returns a positive value on convergence and a negative one
+ * on failure:
+ * - 1: ||F|| <= absolute_tolerance
+ * - 2: ||F|| <= relative_tolerance times the initial ||F||
+ * - 3: the step was at most step_tolerance times (1+||x||)
+ * - -1: maximum_nonlinear_iterations reached
+ * - -2: the line search failed to find sufficient decrease
+ * - -3: a user function returned an error
+ * - -4: GMRES broke down on a singular Newton system
+ *
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *    - \b maximum_nonlinear_iterations
+ *       maximum number of Newton iterations
+ *
+ *    - \b absolute_tolerance
+ *       absolute convergence tolerance on ||F||
+ *
+ *    - \b relative_tolerance
+ *       convergence tolerance on ||F|| relative to its initial value
+ *
+ *    - \b step_tolerance
+ *       convergence tolerance on ||lambda dx||/(1+||x||)
+ *
+ *    - \b forcing_term_strategy
+ *       "CONSTANT", "EWCHOICE1" or "EWCHOICE2"
+ *
+ *    - \b constant_forcing_term
+ *       forcing term of the "CONSTANT" strategy
+ *
+ *    - \b initial_forcing_term
+ *       forcing term of the first step with the Eisenstat-Walker rules
+ *
+ *    - \b maximum_forcing_term
+ *       upper bound of the Eisenstat-Walker forcing terms
+ *
+ *    - \b EW_choice2_alpha, EW_choice2_gamma
+ *       eta = gamma*(||F_new||/||F_old||)^alpha for "EWCHOICE2"
+ *
+ *    - \b maximum_linear_iterations
+ *       maximum number of GMRES iterations per Newton step
+ *
+ *    - \b maximum_gmres_krylov_dimension
+ *       number of GMRES iterations between restarts
+ *
+ *    - \b maximum_line_search_backtracks
+ *       maximum number of step reductions per Newton step
+ *
+ *    - \b uses_preconditioner
+ *       whether the user's preconditioner is applied
+ *
+ *    - \b uses_explicit_jacobian
+ *       whether the user's jacobianTimesVector() replaces the finite
+ *       difference approximation
+ *
+ *    - \b function_evaluation_error
+ *       relative error in evaluating F, which scales the differencing
+ *       parameter
+ *
+ *    - \b enable_logging
+ *       log the progress of each Newton iteration
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>maximum_nonlinear_iterations</td>
+ *     <td>int</td>
+ *     <td>50</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>absolute_tolerance</td>
+ *     <td>double</td>
+ *     <td>1.0e-10</td>
+ *     <td>>=0.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>relative_tolerance</td>
+ *     <td>double</td>
+ *     <td>1.0e-8</td>
+ *     <td>>=0.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>step_tolerance</td>
+ *     <td>double</td>
+ *     <td>1.0e-14</td>
+ *     <td>>=0.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>forcing_term_strategy</td>
+ *     <td>string</td>
+ *     <td>"EWCHOICE2"</td>
+ *     <td>"CONSTANT", "EWCHOICE1", "EWCHOICE2"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>constant_forcing_term</td>
+ *     <td>double</td>
+ *     <td>0.1</td>
+ *     <td>>0.0 and <1.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>initial_forcing_term</td>
+ *     <td>double</td>
+ *     <td>0.5</td>
+ *     <td>>0.0 and <1.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>maximum_forcing_term</td>
+ *     <td>double</td>
+ *     <td>0.9</td>
+ *     <td>>0.0 and <1.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>EW_choice2_alpha</td>
+ *     <td>double</td>
+ *     <td>2.0</td>
+ *     <td>>1.0 and <=2.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>EW_choice2_gamma</td>
+ *     <td>double</td>
+ *     <td>0.9</td>
+ *     <td>>0.0 and <=1.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>maximum_linear_iterations</td>
+ *     <td>int</td>
+ *     <td>100</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>maximum_gmres_krylov_dimension</td>
+ *     <td>int</td>
+ *     <td>20</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>maximum_line_search_backtracks</td>
+ *     <td>int</td>
+ *     <td>10</td>
+ *     <td>>=0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>uses_preconditioner</td>
+ *     <td>bool</td>
+ *     <td>TRUE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>uses_explicit_jacobian</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>function_evaluation_error</td>
+ *     <td>double</td>
+ *     <td>1.0e-8</td>
+ *     <td>>0.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>enable_logging</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ * </table>
+ *
+ * @see NewtonKrylovAbstractFunctions
+ */
+
+class NewtonKrylovSolver:
+   public NonlinearSolverStrategy
+{
+public:
+   /*!
+    * Constructor.
+    *
+    * @param object_name Object name
+    * @param my_functions User functions defining F and the
+    *                     preconditioner
+    * @param input_db Input database with initialization parameters
+    *
+    * @pre !object_name.empty()
+    * @pre my_functions != 0
+    */
+   NewtonKrylovSolver(
+      const std::string& object_name,
+      NewtonKrylovAbstractFunctions* my_functions,
+      const std::shared_ptr<tbox::Database>& input_db =
+         std::shared_ptr<tbox::Database>());
+
+   /*!
+    * Virtual destructor.
+    */
+   virtual ~NewtonKrylovSolver();
+
+   /*!
+    * @brief Set the solution vector and allocate the work vectors,
+    * which are clones of it.
+    *
+    * @pre solution
+    */
+   void
+   initialize(
+      const std::shared_ptr<SAMRAIVectorReal<double> >& solution);
+
+   /*!
+    * @brief Solve F(x)=0, starting from and overwriting the solution
+    * vector.
+    *
+    * @return a positive value on convergence and a negative one on
+    * failure, as listed in the class description
+    *
+    * @pre the solver has been initialized
+    */
+   int
+   solve();
+
+   /*!
+    * @brief Return the number of Newton iterations of the last solve.
+    */
+   int
+   getNumberOfNonlinearIterations() const
+   {
+      return d_number_nonlinear_iterations;
+   }
+
+   /*!
+    * @brief Return the total number of GMRES iterations of the last
+    * solve.
+    */
+   int
+   getTotalNumberOfLinearIterations() const
+   {
+      return d_number_linear_iterations;
+   }
+
+   /*!
+    * @brief Return the number of evaluations of F in the last solve,
+    * including those of the Jacobian-vector products.
+    */
+   int
+   getNumberOfFunctionEvaluations() const
+   {
+      return d_number_function_evaluations;
+   }
+
+   /*!
+    * @brief Return ||F|| at the end of the last solve.
+    */
+   double
+   getFunctionNorm() const
+   {
+      return d_function_norm;
+   }
+
+   /*!
+    * @brief Return the name of this object.
+    */
+   const std::string&
+   getObjectName() const
+   {
+      return d_object_name;
+   }
+
+private:
+   // The following are not implemented:
+   NewtonKrylovSolver(
+      const NewtonKrylovSolver&);
+   NewtonKrylovSolver&
+   operator = (
+      const NewtonKrylovSolver&);
+
+   /*!
+    * @brief Read input parameters from the input database.
+    */
+   void
+   getFromInput(
+      const std::shared_ptr<tbox::Database>& input_db);
+
+   /*!
+    * @brief Free the work vectors, if allocated.
+    */
+   void
+   deallocateVectors();
+
+   /*!
+    * @brief Evaluate f=F(x), counting the evaluation.
+    *
+    * @return whether the user function succeeded
+    */
+   bool
+   evaluateFunction(
+      const std::shared_ptr<SAMRAIVectorReal<double> >& x,
+      const std::shared_ptr<SAMRAIVectorReal<double> >& f);
+
+   /*!
+    * @brief Set y=J(x)v, where x is the solution vector and
+    * d_function_vector holds F(x).
+    *
+    * @return whether the user functions succeeded
+    */
+   bool
+   applyJacobian(
+      const std::shared_ptr<SAMRAIVectorReal<double> >& v,
+      const std::shared_ptr<SAMRAIVectorReal<double> >& y);
+
+   /*!
+    * @brief Solve J(x) dx = -F(x) into d_step_vector by flexible GMRES
+    * to the given relative tolerance.
+    *
+    * @param forcing_term relative tolerance
+    * @param linear_residual_norm (OUT) ||F+J dx|| at exit
+    *
+    * @return 0 on success, -3 if a user function failed, or -4 if
+    * GMRES broke down before making any progress
+    */
+   int
+   solveNewtonSystem(
+      double forcing_term,
+      double& linear_residual_norm);
+
+   /*!
+    * @brief Sum the first count entries of d_local_dots into
+    * d_global_dots over all processes.
+    */
+   void
+   sumLocalDots(
+      int count);
+
+   std::string d_object_name;
+
+   NewtonKrylovAbstractFunctions* d_functions;
+
+   //@{
+   /*!
+    * @name Parameters from input.
+    */
+   int d_max_nonlinear_iterations;
+   double d_absolute_tolerance;
+   double d_relative_tolerance;
+   double d_step_tolerance;
+   std::string d_forcing_term_strategy;
+   double d_constant_forcing_term;
+   double d_initial_forcing_term;
+   double d_max_forcing_term;
+   double d_ew_choice2_alpha;
+   double d_ew_choice2_gamma;
+   int d_max_linear_iterations;
+   int d_max_krylov_dimension;
+   int d_max_backtracks;
+   bool d_uses_preconditioner;
+   bool d_uses_explicit_jacobian;
+   double d_function_evaluation_error;
+   bool d_enable_logging;
+   //@}
+
+   //@{
+   /*!
+    * @name Solution vector-dependent data.
+    *
+    * These are set by initialize().
+    */
+   std::shared_ptr<SAMRAIVectorReal<double> > d_solution_vector;
+
+   /*!
+    * @brief F at the solution vector.
+    */
+   std::shared_ptr<SAMRAIVectorReal<double> > d_function_vector;
+
+   /*!
+    * @brief Newton step dx.
+    */
+   std::shared_ptr<SAMRAIVectorReal<double> > d_step_vector;
+
+   /*!
+    * @brief Trial point of the line search and of the finite
+    * difference Jacobian, and F there.
+    */
+   std::shared_ptr<SAMRAIVectorReal<double> > d_trial_vector;
+   std::shared_ptr<SAMRAIVectorReal<double> > d_trial_function_vector;
+
+   /*!
+    * @brief Orthonormal GMRES basis, with one extra vector for the
+    * new direction.
+    */
+   std::vector<std::shared_ptr<SAMRAIVectorReal<double> > > d_basis_vectors;
+
+   /*!
+    * @brief Preconditioned GMRES basis vectors.
+    */
+   std::vector<std::shared_ptr<SAMRAIVectorReal<double> > >
+   d_preconditioned_vectors;
+
+   tbox::SAMRAI_MPI d_mpi;
+   //@}
+
+   //@{
+   /*!
+    * @name GMRES state.
+    */
+   std::vector<double> d_hessenberg;
+   std::vector<double> d_givens_cos;
+   std::vector<double> d_givens_sin;
+   std::vector<double> d_rhs_coefs;
+   std::vector<double> d_local_dots;
+   std::vector<double> d_global_dots;
+   //@}
+
+   //@{
+   /*!
+    * @name Statistics of the last solve.
+    */
+   int d_number_nonlinear_iterations;
+   int d_number_linear_iterations;
+   int d_number_function_evaluations;
+   double d_function_norm;
+   double d_solution_norm;
+   //@}
+
+   std::shared_ptr<tbox::Timer> t_solve;
+   std::shared_ptr<tbox::Timer> t_linear_solve;
+   std::shared_ptr<tbox::Timer> t_line_search;
+};
+
+}
+}
+
+#endif
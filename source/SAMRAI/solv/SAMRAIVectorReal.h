@@ -23,6 +23,7 @@
 #include <string>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace solv {
@@ -72,6 +73,13 @@ namespace solv {
  * - @b (3) Manipulate data using vector operations.
  *
  *
+ * The summing operations compute the contribution of every component
+ * on the local process before a single global reduction, so their
+ * communication cost does not grow with the number of components.
+ * multiDot() extends this to several dot products, and linearSumDot()
+ * and linearSumL2Norm() fuse a linear sum with the reduction that
+ * commonly follows it.
+ *
  * Before the vector operations can be used, the storage for each of its
  * components must be allocated.  Storage allocation is only possible
  * through a vector object after all component variables are added to
@@ -600,6 +608,47 @@ public:
       const std::shared_ptr<SAMRAIVectorReal<TYPE> >& x,
       bool local_only = false) const;
 
+   /**
+    * Compute the dot products of this vector with each of the vectors in
+    * x, in the same sense as dot(), and store them in dots, which is
+    * resized to the number of vectors.  All of the products are summed
+    * over processes in a single reduction, unless local_only is true.
+    */
+   void
+   multiDot(
+      const std::vector<std::shared_ptr<SAMRAIVectorReal<TYPE> > >& x,
+      std::vector<TYPE>& dots,
+      bool local_only = false) const;
+
+   /**
+    * Set this vector to the linear sum @f$ \alpha x + \beta y @f$  on the
+    * patch interiors and return the dot product of the result with w.
+    * For components whose hierarchy operations support it, such as cell
+    * data, the sum and the product are computed in one pass over the
+    * patches.  w may be this vector.
+    */
+   TYPE
+   linearSumDot(
+      const TYPE& alpha,
+      const std::shared_ptr<SAMRAIVectorReal<TYPE> >& x,
+      const TYPE& beta,
+      const std::shared_ptr<SAMRAIVectorReal<TYPE> >& y,
+      const std::shared_ptr<SAMRAIVectorReal<TYPE> >& w,
+      bool local_only = false);
+
+   /**
+    * Set this vector to the linear sum @f$ \alpha x + \beta y @f$  on the
+    * patch interiors and return the @f$ L_2 @f$ -norm of the result, as
+    * linearSumDot() does.
+    */
+   double
+   linearSumL2Norm(
+      const TYPE& alpha,
+      const std::shared_ptr<SAMRAIVectorReal<TYPE> >& x,
+      const TYPE& beta,
+      const std::shared_ptr<SAMRAIVectorReal<TYPE> >& y,
+      bool local_only = false);
+
    /**
     * Return 1 if @f$ \|x_i\| > 0 @f$  and @f$ w_i * x_i \leq 0 @f$ , for any @f$ i @f$  in
     * the set of vector data indices, where @f$ cvol_i > 0 @f$ .  Here, @f$ w_i @f$  is
@@ -139,7 +139,7 @@ c***********************************************************************
 
       do j=jfirst,jlast
 c        offset must be 0 (red) or 1 (black)
-         if ( (jfirst+j)-((jfirst+j)/2*2) .ne. offset ) then
+         if ( abs(ifirst+j)-(abs(ifirst+j)/2*2) .ne. offset ) then
             ioffset = 1
          else
             ioffset = 0
@@ -206,7 +206,7 @@ c***********************************************************************
 
       do j=jfirst,jlast
 c        offset must be 0 (red) or 1 (black)
-         if ( (jfirst+j)-((jfirst+j)/2*2) .ne. offset ) then
+         if ( abs(ifirst+j)-(abs(ifirst+j)/2*2) .ne. offset ) then
             ioffset = 1
          else
             ioffset = 0
@@ -275,7 +275,7 @@ c***********************************************************************
 
       do j=jfirst,jlast
 c        offset must be 0 (red) or 1 (black)
-         if ( (jfirst+j)-((jfirst+j)/2*2) .ne. offset ) then
+         if ( abs(ifirst+j)-(abs(ifirst+j)/2*2) .ne. offset ) then
             ioffset = 1
          else
             ioffset = 0
@@ -341,7 +341,7 @@ c***********************************************************************
 
       do j=jfirst,jlast
 c        offset must be 0 (red) or 1 (black)
-         if ( (jfirst+j)-((jfirst+j)/2*2) .ne. offset ) then
+         if ( abs(ifirst+j)-(abs(ifirst+j)/2*2) .ne. offset ) then
             ioffset = 1
          else
             ioffset = 0
@@ -15,6 +15,7 @@
 
 #include "SAMRAI/tbox/DatabaseBox.h"
 #include "SAMRAI/tbox/Complex.h"
+#include "SAMRAI/tbox/MessageStream.h"
 #include "SAMRAI/tbox/PIO.h"
 #include "SAMRAI/tbox/Utilities.h"
 
@@ -1630,6 +1631,34 @@ public:
     */
    virtual void copyDatabase(const std::shared_ptr<Database>& database);
 
+   /*!
+    * @brief Pack all keys and values of this database, including nested
+    * databases, into a message stream.
+    *
+    * The packed form is a flat byte sequence that can be sent between
+    * processes or written as one contiguous dataset, and is read back
+    * by getFromMessageStream() on the same architecture.
+    *
+    * @param stream  Write-mode stream that grows as needed
+    *
+    * @pre stream.writeMode()
+    */
+   virtual void
+   putToMessageStream(
+      MessageStream& stream);
+
+   /*!
+    * @brief Unpack keys and values packed by putToMessageStream() into
+    * this database.
+    *
+    * @param stream  Read-mode stream positioned at the packed database
+    *
+    * @pre stream.readMode()
+    */
+   virtual void
+   getFromMessageStream(
+      MessageStream& stream);
+
 #ifdef SAMRAI_HAVE_CONDUIT
    /*!
     * @brief Write data held in this database to a Conduit Node
@@ -1652,6 +1681,28 @@ public:
    printClassData(
       std::ostream& os = pout) = 0;
 
+protected:
+   /*!
+    * @brief Unpack the value of one key packed by putToMessageStream()
+    * and put it into this database.
+    *
+    * Used by getFromMessageStream() for all types except nested
+    * databases, after the key name, type and size have been read.
+    *
+    * @param stream  Read-mode stream positioned at the packed value
+    * @param key     Key to put the value under
+    * @param my_type Type of the packed value, not SAMRAI_DATABASE
+    * @param size    Number of packed values
+    *
+    * @pre stream.readMode()
+    */
+   void
+   getKeyFromMessageStream(
+      MessageStream& stream,
+      const std::string& key,
+      const DataType my_type,
+      const size_t size);
+
 private:
    // Unimplemented copy constructor.
    Database(
@@ -76,6 +76,47 @@ public:
     */
    virtual ~HDFDatabase();
 
+   /*!
+    * @brief Set lossless compression of the double, float, integer and
+    * complex arrays written afterwards to this database and to the
+    * databases later put into it.
+    *
+    * Arrays of at least 64 elements are written as chunked datasets
+    * with the byte shuffle and deflate (gzip) filters of stock HDF5.
+    * Each array is one chunk of up to max_chunk_size elements, so the
+    * array of a patch data component is compressed and read as a unit.
+    * Compressed files are read without any setting.
+    *
+    * @param deflate_level   Deflate level 1 (fastest) to 9 (smallest),
+    *                        or 0 for no compression
+    * @param shuffle         Whether to shuffle bytes before deflating
+    * @param max_chunk_size  Maximum number of elements in a chunk
+    *
+    * @pre deflate_level >= 0 && deflate_level <= 9
+    * @pre max_chunk_size > 0
+    */
+   void
+   setCompression(
+      const int deflate_level,
+      const bool shuffle = true,
+      const size_t max_chunk_size = s_default_max_chunk_size);
+
+   /*!
+    * @brief Set lossy compression of the double and float arrays written
+    * afterwards to this database and to the databases later put into it.
+    *
+    * The HDF5 scale-offset filter stores each value truncated to
+    * decimal_digits digits after the decimal point, so the absolute error
+    * is at most 1e-decimal_digits.  This is intended for plot data,
+    * not restart data.  It may be combined with setCompression().
+    *
+    * @param decimal_digits  Number of decimal digits kept, or a negative
+    *                        value for lossless storage
+    */
+   void
+   setLossyCompression(
+      const int decimal_digits);
+
    /**
     * Return true if the specified key exists in the database
     * and false otherwise.
@@ -422,6 +463,46 @@ public:
    getStringVector(
       const std::string& key);
 
+   /*!
+    * @brief Return true if the specified key represents a byte array
+    * written by putByteArray().  If the key does not exist, then false
+    * is returned.
+    */
+   bool
+   isByteArray(
+      const std::string& key);
+
+   /*!
+    * @brief Create a byte array entry in the database with the
+    * specified key name.
+    *
+    * The bytes are stored as a one-dimensional H5T_NATIVE_UCHAR
+    * dataset, so binary data such as a packed MessageStream is written
+    * unchanged and compressed like the other arrays.  A byte array is
+    * not one of the Database data types; getArrayType() returns
+    * SAMRAI_INVALID for it and it is read only by getByteVector().
+    *
+    * @pre !key.empty()
+    * @pre data != 0
+    */
+   void
+   putByteArray(
+      const std::string& key,
+      const void * const data,
+      const size_t nbytes);
+
+   /*!
+    * @brief Get a byte array entry from the database with the specified
+    * key name.  If the key is not a byte array then an error message is
+    * printed and the program exits.
+    *
+    * @pre !key.empty()
+    * @pre isByteArray(key)
+    */
+   std::vector<char>
+   getByteVector(
+      const std::string& key);
+
    /**
     * Print contents of current database to the specified output stream.
     * If no output stream is specified, then data is written to stream pout.
@@ -639,6 +720,18 @@ private:
    readAttribute(
       hid_t dataset_id);
 
+   /*!
+    * @brief Create the dataset creation property list for an array of
+    * nelements, applying the compression settings.
+    *
+    * @return H5P_DEFAULT if the array is not filtered, otherwise a
+    * property list the caller must close.
+    */
+   hid_t
+   createDatasetProperties(
+      const size_t nelements,
+      const bool is_floating_point) const;
+
    struct hdf_complex {
       double re;
       double im;
@@ -693,6 +786,21 @@ private:
     */
    std::list<KeyData> d_keydata;
 
+   /*
+    * Compression settings for array datasets; see setCompression() and
+    * setLossyCompression().
+    */
+   int d_deflate_level;
+   bool d_shuffle;
+   size_t d_max_chunk_size;
+   int d_lossy_digits;
+
+   /*
+    * Smallest array that is filtered, and default maximum chunk size.
+    */
+   static const size_t s_min_compressed_size;
+   static const size_t s_default_max_chunk_size;
+
    /*
     *************************************************************************
     *
@@ -711,6 +819,7 @@ private:
    static const int KEY_FLOAT_ARRAY;
    static const int KEY_INT_ARRAY;
    static const int KEY_STRING_ARRAY;
+   static const int KEY_BYTE_ARRAY;
    static const int KEY_BOOL_SCALAR;
    static const int KEY_BOX_SCALAR;
    static const int KEY_CHAR_SCALAR;
@@ -719,6 +828,7 @@ private:
    static const int KEY_FLOAT_SCALAR;
    static const int KEY_INT_SCALAR;
    static const int KEY_STRING_SCALAR;
+   static const int KEY_BYTE_SCALAR;
 
 };
 
@@ -20,7 +20,9 @@ namespace tbox {
 /**
  * @brief HDFDatabase factory.
  *
- * Builds a new HDFDatabase.
+ * Builds a new HDFDatabase, with the compression set by setCompression().
+ * Giving a factory with compression to
+ * RestartManager::setDatabaseFactory() compresses the restart files.
  */
 class HDFDatabaseFactory:public DatabaseFactory
 {
@@ -54,6 +56,21 @@ public:
    virtual std::shared_ptr<Database>
    allocate(
       const std::string& name);
+
+   /**
+    * Set the lossless compression of the databases built afterwards.
+    * See HDFDatabase::setCompression().
+    *
+    * @pre deflate_level >= 0 && deflate_level <= 9
+    */
+   void
+   setCompression(
+      const int deflate_level,
+      const bool shuffle = true);
+
+private:
+   int d_deflate_level;
+   bool d_shuffle;
 };
 
 }
@@ -30,7 +30,9 @@ namespace tbox {
  * as a singleton to be consistent with the restart manager class.
  *
  * All processors must call the parsing routines.  Any errors are reported
- * to pout and will result in termination of the program.
+ * to pout and will result in termination of the program.  Only processor
+ * zero reads and parses the input file; the resulting database is packed
+ * and broadcast to the other processors in a single message.
  *
  * The input file will generally have the following format.  For each
  * object that requires user specified input, an entry of the following
@@ -16,6 +16,7 @@
 #include "SAMRAI/tbox/Database.h"
 
 #include <map>
+#include <memory>
 
 namespace SAMRAI {
 namespace tbox {
@@ -875,6 +876,26 @@ public:
    printClassData(
       std::ostream& os = pout);
 
+   /**
+    * Unpack a database packed by putToMessageStream() into this database
+    * without copying its integer, float, double and character arrays.
+    * Each such array stays in the stream buffer until a get call for its
+    * key reads it, so for a buffer mapped from a file only the arrays
+    * actually used are read from disk.  The buffer must be owned by
+    * mapping, which is kept by this database and its nested databases
+    * until they are destroyed.
+    *
+    * @param stream  Read-mode stream over the buffer owned by mapping
+    * @param mapping Owner of the stream buffer
+    *
+    * @pre stream.readMode()
+    * @pre mapping
+    */
+   void
+   getFromMappedStream(
+      MessageStream& stream,
+      const std::shared_ptr<const char>& mapping);
+
    /**
     * Print the database keys that were not used to the specified output
     * stream.
@@ -925,6 +946,7 @@ private:
       std::vector<float> d_float;               // float vector value
       std::vector<int> d_integer;               // integer vector value
       std::vector<std::string> d_string;        // string vector value
+      const char* d_mapped_data;                // array not yet read
    };
 
    /*
@@ -940,6 +962,9 @@ private:
    findKeyDataOrExit(
       const std::string& key);
    static void
+   loadMappedData(
+      KeyData& keydata);
+   static void
    indentStream(
       std::ostream& os,
       const long indent)
@@ -960,6 +985,11 @@ private:
    std::string d_database_name;
    std::map<std::string, KeyData> d_keyvalues;
 
+   /*
+    * Owner of the buffer holding the arrays not yet read, if any.
+    */
+   std::shared_ptr<const char> d_mapping;
+
    static const int PRINT_DEFAULT;
    static const int PRINT_INPUT;
    static const int PRINT_UNUSED;
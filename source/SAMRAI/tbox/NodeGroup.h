@@ -0,0 +1,328 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2019 Lawrence Livermore National Security, LLC
+ * Description:   Grouping of the processes of a communicator by compute node
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_NodeGroup
+#define included_tbox_NodeGroup
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/SharedMemoryWindow.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
+
+#include <memory>
+#include <vector>
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Class NodeGroup partitions the processes of a communicator
+ * into groups sharing a compute node.
+ *
+ * Each group has a leader, the process with node-local rank 0.  The
+ * object holds a node communicator connecting the processes on the
+ * local node and, on leaders, a leader communicator connecting one
+ * process per node.  The rank of a leader in the leader communicator
+ * is the index of its node.  Every process also knows the node index
+ * and node-local rank of every other process in the parent
+ * communicator, so questions such as "is rank r on my node?" are
+ * answered without communication.
+ *
+ * Nodes are found with MPI_Comm_split_type(MPI_COMM_TYPE_SHARED).
+ * For testing node-aware algorithms on a single node, a positive
+ * emulated node size groups consecutive ranks into nodes of that size
+ * instead.
+ *
+ * A NodeGroup can also hold a SharedMemoryWindow over the node
+ * communicator, shared by all users of the group.
+ *
+ * Because constructing a NodeGroup is collective and creates new
+ * communicators, getNodeGroup() caches the groups it builds.  The
+ * cached groups are freed at SAMRAI shutdown, in reverse order of
+ * creation so that the collective frees match on all processes.
+ */
+class NodeGroup
+{
+public:
+   /*!
+    * @brief Construct the node grouping of a communicator.
+    *
+    * This is collective over mpi.
+    *
+    * @param[in] mpi  The parent communicator.
+    * @param[in] emulated_node_size  If positive, group consecutive
+    * ranks into nodes of this size rather than querying MPI for
+    * shared-memory nodes.
+    *
+    * @pre emulated_node_size >= 0
+    */
+   explicit NodeGroup(
+      const SAMRAI_MPI& mpi,
+      int emulated_node_size = 0);
+
+   /*!
+    * @brief Destructor frees the shared memory window and the node and
+    * leader communicators.
+    */
+   ~NodeGroup();
+
+   /*!
+    * @brief Get the cached NodeGroup for a communicator, constructing
+    * it if needed.
+    *
+    * The first call for a given communicator and emulated node size is
+    * collective over mpi.  The cache entry is found through an MPI
+    * attribute of the communicator, and is dropped when the
+    * communicator is freed, so a new communicator that reuses the
+    * handle of a freed one gets a new group.
+    */
+   static std::shared_ptr<NodeGroup>
+   getNodeGroup(
+      const SAMRAI_MPI& mpi,
+      int emulated_node_size = 0);
+
+   /*!
+    * @brief Drop the cached groups of the communicator with the given
+    * serial number.
+    *
+    * Only called when that communicator is freed.
+    */
+   static void
+   forgetCommunicator(
+      int comm_serial);
+
+   /*!
+    * @brief Return the parent communicator.
+    */
+   const SAMRAI_MPI&
+   getMPI() const
+   {
+      return d_mpi;
+   }
+
+   /*!
+    * @brief Return the communicator of the processes on the local node.
+    */
+   const SAMRAI_MPI&
+   getNodeMPI() const
+   {
+      return d_node_mpi;
+   }
+
+   /*!
+    * @brief Return the communicator connecting node leaders.
+    *
+    * On processes that are not leaders, the communicator is
+    * MPI_COMM_NULL.
+    */
+   const SAMRAI_MPI&
+   getLeaderMPI() const
+   {
+      return d_leader_mpi;
+   }
+
+   /*!
+    * @brief Whether the local process is the leader of its node.
+    */
+   bool
+   isLeader() const
+   {
+      return d_node_mpi.getRank() == 0;
+   }
+
+   /*!
+    * @brief Return the number of nodes.
+    */
+   int
+   getNumberOfNodes() const
+   {
+      return static_cast<int>(d_leader_of_node.size());
+   }
+
+   /*!
+    * @brief Return the index of the local node.
+    */
+   int
+   getNodeIndex() const
+   {
+      return d_node_of_rank[d_mpi.getRank()];
+   }
+
+   /*!
+    * @brief Return the index of the node holding the given rank of the
+    * parent communicator.
+    *
+    * @pre rank >= 0 && rank < getMPI().getSize()
+    */
+   int
+   getNodeIndex(
+      int rank) const
+   {
+      TBOX_ASSERT(rank >= 0 && rank < d_mpi.getSize());
+      return d_node_of_rank[rank];
+   }
+
+   /*!
+    * @brief Return the node-local rank of the given rank of the parent
+    * communicator.
+    *
+    * @pre rank >= 0 && rank < getMPI().getSize()
+    */
+   int
+   getNodeRank(
+      int rank) const
+   {
+      TBOX_ASSERT(rank >= 0 && rank < d_mpi.getSize());
+      return d_node_rank_of_rank[rank];
+   }
+
+   /*!
+    * @brief Return the parent-communicator rank of the leader of the
+    * given node.
+    *
+    * @pre node_index >= 0 && node_index < getNumberOfNodes()
+    */
+   int
+   getLeaderRank(
+      int node_index) const
+   {
+      TBOX_ASSERT(node_index >= 0 && node_index < getNumberOfNodes());
+      return d_leader_of_node[node_index];
+   }
+
+   /*!
+    * @brief Whether the given rank of the parent communicator is on
+    * the local node.
+    */
+   bool
+   isOnNode(
+      int rank) const
+   {
+      return getNodeIndex(rank) == getNodeIndex();
+   }
+
+   /*!
+    * @brief Get the node's shared memory window, allocating it on the
+    * first call.
+    *
+    * The first call is collective over the node communicator and must
+    * pass the same segment_size on all processes.  Later calls return
+    * the existing window and ignore segment_size.
+    *
+    * @param[in] segment_size  Bytes contributed by each process.
+    *
+    * @pre SharedMemoryWindow::isAvailable()
+    */
+   const std::shared_ptr<SharedMemoryWindow>&
+   getSharedMemoryWindow(
+      size_t segment_size);
+
+private:
+   NodeGroup(
+      const NodeGroup&);                // not implemented
+   NodeGroup&
+   operator = (
+      const NodeGroup&);                // not implemented
+
+   /*!
+    * @brief Free the cached groups.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   shutdownCallback()
+   {
+      while (!s_node_groups.empty()) {
+         s_node_groups.pop_back();
+      }
+      freeCommKeyval();
+   }
+
+   /*!
+    * @brief Free the MPI attribute key of the serial numbers.
+    */
+   static void
+   freeCommKeyval();
+
+   /*!
+    * @brief The parent communicator (not owned).
+    */
+   SAMRAI_MPI d_mpi;
+
+   /*!
+    * @brief Communicator of the processes on the local node.
+    */
+   SAMRAI_MPI d_node_mpi;
+
+   /*!
+    * @brief Communicator of the node leaders, or MPI_COMM_NULL on
+    * processes that are not leaders.
+    */
+   SAMRAI_MPI d_leader_mpi;
+
+   /*!
+    * @brief Node index of each rank of the parent communicator.
+    */
+   std::vector<int> d_node_of_rank;
+
+   /*!
+    * @brief Node-local rank of each rank of the parent communicator.
+    */
+   std::vector<int> d_node_rank_of_rank;
+
+   /*!
+    * @brief Parent-communicator rank of the leader of each node.
+    */
+   std::vector<int> d_leader_of_node;
+
+   /*!
+    * @brief Emulated node size given to the constructor.
+    */
+   int d_emulated_node_size;
+
+   /*!
+    * @brief Serial number of the parent communicator in the cache.
+    */
+   int d_comm_serial;
+
+   /*!
+    * @brief Shared memory window over the node communicator.
+    */
+   std::shared_ptr<SharedMemoryWindow> d_shared_memory_window;
+
+   /*!
+    * @brief Groups built by getNodeGroup(), in order of creation.
+    */
+   static std::vector<std::shared_ptr<NodeGroup> > s_node_groups;
+
+   /*!
+    * @brief Return the serial number identifying a communicator in the
+    * cache, attaching a new one if the communicator has none.
+    */
+   static int
+   getCommSerial(
+      const SAMRAI_MPI& mpi);
+
+   /*!
+    * @brief MPI attribute key of the serial numbers, or -1 before the
+    * first use, and the last serial number given out.
+    */
+   static int s_comm_keyval;
+   static int s_last_comm_serial;
+
+   static StartupShutdownManager::Handler s_shutdown_handler;
+
+};
+
+}
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include <cstdio>
 #include <string>
 #include <list>
+#include <map>
 #include <memory>
 
 namespace SAMRAI {
@@ -30,7 +31,20 @@ namespace tbox {
  * running on multiple processors, only node zero reads in data from the
  * specified input file and broadcasts that data to the other processors.
  * The input file argument for the other processors is ignored and may be
- * NULL.
+ * NULL.  Alternatively, a single process may parse the input file on its
+ * own (see parse()), as InputManager does before broadcasting the
+ * resulting database.
+ *
+ * The text of include files is cached for the life of the program, so
+ * that an include file shared by several input files or included several
+ * times is read from the file system only once.  The cache is keyed by
+ * file name only: the name in the include directive, prefixed with the
+ * directory of the input file unless it is an absolute path.  The same
+ * file reached through two names is read twice, and neither the contents
+ * nor the modification time of a cached file are checked.  Entries are
+ * never invalidated during a run, so an include file that is rewritten
+ * while the program runs is not reread until clearIncludeCache() is
+ * called.  InputManager clears the cache at shutdown.
  *
  * The parser class also defines a ``default'' parser that may be accessed
  * via a static member function.  The default parser may only be accessed
@@ -72,12 +86,17 @@ public:
     * is ignored on other nodes and may be set to NULL.  Multiple input
     * files may be parsed by calling parse() for each file, but all variables
     * are reset at the beginning of each parse.
+    *
+    * If collective is false, only the calling process parses the input,
+    * reading fstream and any include files itself without communication,
+    * and fstream must be valid on that process.
     */
    int
    parse(
       const std::string& filename,
       FILE* fstream,
-      const std::shared_ptr<Database>& database);
+      const std::shared_ptr<Database>& database,
+      const bool collective = true);
 
    /**
     * Return the total number of errors resulting from the parse.
@@ -108,6 +127,17 @@ public:
       return s_default_parser;
    }
 
+   /**
+    * Discard the cached text of all include files, so that they are read
+    * again from the file system when next included.  This is the only way
+    * a cache entry is invalidated.
+    */
+   static void
+   clearIncludeCache()
+   {
+      s_include_cache.clear();
+   }
+
    /**
     * Return the current database scope.  The current scope is modified
     * through the enterScope() and leaveScope() member functions.
@@ -215,7 +245,8 @@ public:
 
    /**
     * Define the input reading routine used by flex.  Under MPI, node zero
-    * reads the input and broadcasts the character data to all processors.
+    * reads the input and broadcasts the character data to all processors,
+    * unless the parse is not collective.
     */
    int
    yyinput(
@@ -229,9 +260,20 @@ private:
    operator = (
       const Parser&);           // not implemented
 
+   /*
+    * Return the text of the specified include file from the include file
+    * cache, reading it into the cache first if needed.  A null pointer
+    * is returned if the file cannot be read.
+    */
+   static std::shared_ptr<const std::string>
+   getIncludeText(
+      const std::string& filename);
+
    struct ParseData {
       std::string d_filename;   // filename for description
       FILE* d_fstream;          // input stream to parse
+      std::shared_ptr<const std::string> d_text; // cached text to parse
+      size_t d_text_position;   // position of next character in d_text
       std::string d_linebuffer; // line being parsed
       int d_linenumber;         // line number in input stream
       int d_cursor;             // cursor position in line
@@ -244,11 +286,15 @@ private:
    std::list<Parser::ParseData> d_parse_stack;
 
    std::list<std::shared_ptr<Database> > d_scope_stack;
+   bool d_collective;           // whether all processors are parsing
 
    static Parser* s_default_parser;
 
    static bool s_static_tables_initialized;
 
+   static std::map<std::string, std::shared_ptr<const std::string> >
+   s_include_cache;
+
    std::string d_pathname;           // path to filename for including
 };
 
@@ -17,9 +17,13 @@
 #include "SAMRAI/tbox/Database.h"
 #include "SAMRAI/tbox/DatabaseFactory.h"
 
+#include <functional>
 #include <string>
 #include <list>
+#include <map>
 #include <memory>
+#include <thread>
+#include <vector>
 
 namespace SAMRAI {
 namespace tbox {
@@ -73,6 +77,60 @@ namespace tbox {
  * both a restart directory name and a restore number for its arguments.
  * See comments for member functions for more details.
  *
+ * By default each process writes its own restart file.  At scale the
+ * number of files and of small writes can overwhelm a parallel file
+ * system, so the processes can instead be divided among a configurable
+ * number of writers (see setNumberOfRestartWriters()), each of which
+ * writes one file for its group of processes.  openRestartFile() reads
+ * either layout.
+ *
+ * A restart written as one file per process may be read by a different
+ * number of processes.  Each process then reads the files of a
+ * contiguous block of the writer ranks, and the patch levels in them are
+ * merged into one level per process (see isFromRedistributedRestart()).
+ *
+ * Writing a restart file normally blocks until the files are closed.
+ * With asynchronous writes enabled (see setAsynchronousRestartWrites())
+ * the restart data is first copied into a MemoryDatabase, and the files
+ * are written from that copy on a helper thread while the simulation
+ * continues.  The write is completed at the start of the next
+ * writeRestartFile() or openRestartFile(), by waitForRestartWrite(), or
+ * at shutdown.
+ *
+ * With incremental writes enabled (see setIncrementalRestartWrites()),
+ * patch data that has not changed since an earlier restart of the same
+ * restart directory is not written again (see
+ * hier::PatchDataRestartManager).  Such patch data is written as a
+ * reference, an "d_incremental_restore_num" entry naming the restore
+ * number holding the data, and openRestartFile() replaces each
+ * reference by the referenced data, so the root database is complete.
+ * A reference always names the restore where the data was last written
+ * in full, so data that never changes keeps referencing the oldest
+ * restore of the directory.  Restore directories written with
+ * incremental writes therefore cannot be pruned while a later restore
+ * may still reference them; to start over from a complete restart,
+ * write to a new directory.
+ *
+ * With mapped restart files enabled (see setMappedRestartFiles()), each
+ * process writes its restart data as one packed MessageStream instead of
+ * through the database factory.  openRestartFile() recognizes such a
+ * file, maps it into memory and unpacks only its structure; the arrays,
+ * which hold the patch data, are read from the file when first accessed
+ * (see MemoryDatabase::getFromMappedStream()).  Restart time is then
+ * proportional to the data the application actually reads.
+ *
+ * For fast recovery, the restart data can also be checkpointed to
+ * memory (see writeMemoryCheckpoint()).  Each process keeps its
+ * serialized restart data and a copy of the data of a buddy process,
+ * placed on another compute node when there is more than one.
+ * openMemoryCheckpoint() makes the last memory checkpoint the root
+ * database, taking the data of a process from its buddy if the process
+ * lost its own copy.  The registered objects are not reset
+ * automatically, since Serializable objects read restart data only when
+ * constructed; the application must reset each object whose state rolls
+ * back from the root database (see, for example,
+ * algs::TimeRefinementIntegrator::resetFromRestart()).
+ *
  * @see Database
  */
 
@@ -102,12 +160,36 @@ public:
       return d_is_from_restart;
    }
 
+   /*!
+    * @brief Returns true if the open restart was written by a different
+    * number of processes than are reading it.
+    *
+    * Each process then holds the patches of the writer processes whose
+    * files it read, so the patch levels are generally not load balanced
+    * and should be repartitioned once they are built.
+    * TimeRefinementIntegrator::initializeHierarchy() does this.
+    */
+   bool
+   isFromRedistributedRestart() const
+   {
+      return d_is_redistributed_restart;
+   }
+
    /**
     * Attempts to mount, for reading, the restart file for the processor.
     * If there is no error opening the file, then the restart manager
     * mounts the restart file.
     * Returns true if open is successful; false otherwise.
     *
+    * If num_nodes differs from the number of processes, process r reads
+    * the files of the writer ranks [num_nodes*r/P, num_nodes*(r+1)/P),
+    * where P is the number of processes, and the restart data is merged
+    * into a MemoryDatabase.  The global data is taken from the first of
+    * these files, or from file num_nodes*r/P if the range is empty.  The
+    * patches and boxes of each patch level are renumbered and given to
+    * process r.  The files may be one file per process or aggregated
+    * files, from which the streams of the writer ranks are read.
+    *
     * @pre hasDatabaseFactory()
     */
    bool
@@ -155,6 +237,7 @@ public:
          d_database_root = database;
          d_is_from_restart = true;
       }
+      d_is_redistributed_restart = false;
    }
 
    /**
@@ -244,6 +327,231 @@ public:
    void
    writeRestartToDatabase();
 
+   /*!
+    * @brief Set the number of processes that write restart files.
+    *
+    * With zero writers (the default) each process writes its own file
+    *
+    *   restart_dirname/restore.[restore number]/nodes.[nprocs]/proc.[rank]
+    *
+    * With n > 0 writers the processes are divided into at most n groups
+    * of consecutive ranks.  Each process packs its restart database into
+    * a byte stream (Database::putToMessageStream()) and sends it to the
+    * first process of its group, which writes
+    *
+    *   restart_dirname/restore.[restore number]/nodes.[nprocs]/group.[group]
+    *
+    * holding the streams of the group as one contiguous byte dataset
+    * and an index of their sizes.  Process 0 also writes the file
+    * "index" in the same directory describing the grouping.  The writer
+    * must hold the restart data of its whole group in memory.  The
+    * files may be read by any number of processes (see
+    * openRestartFile()).
+    *
+    * @param num_writers  Number of writer processes, or 0 for one file
+    *                     per process
+    *
+    * @pre num_writers >= 0
+    */
+   void
+   setNumberOfRestartWriters(
+      const int num_writers)
+   {
+      TBOX_ASSERT(num_writers >= 0);
+      d_num_restart_writers = num_writers;
+   }
+
+   /*!
+    * @brief Return the number of processes that write restart files, 0
+    * if each process writes its own file.
+    */
+   int
+   getNumberOfRestartWriters() const
+   {
+      return d_num_restart_writers;
+   }
+
+   /*!
+    * @brief Set whether restart files are written asynchronously.
+    *
+    * When true, writeRestartFile() returns once the restart data of
+    * this process has been copied into memory (and, with aggregated
+    * files, sent to the writers).  The files are then written by a
+    * helper thread, so the memory for one extra copy of the restart
+    * data is needed until the write completes.
+    *
+    * An error in the helper thread aborts the run from that thread, so
+    * with MPI the helper is used only if MPI provides
+    * MPI_THREAD_MULTIPLE.  Otherwise a warning is issued and writes
+    * remain synchronous.  Files written through the database factory
+    * are written by the helper only if the factory is an
+    * HDFDatabaseFactory and HDF5 was built thread safe, so that the
+    * application may keep using HDF5 during the write.  Other restart
+    * files are written synchronously.  Mapped restart files do not use
+    * the database factory.
+    *
+    * This must be set to the same value on all processes.
+    */
+   void
+   setAsynchronousRestartWrites(
+      const bool async_writes);
+
+   /*!
+    * @brief Return true if restart files are written asynchronously.
+    */
+   bool
+   getAsynchronousRestartWrites() const
+   {
+      return d_async_restart_writes;
+   }
+
+   /*!
+    * @brief Block until the restart write in progress on this process,
+    * if any, has completed.
+    *
+    * This is a local operation; it does not synchronize with other
+    * processes.
+    */
+   void
+   waitForRestartWrite();
+
+   /*!
+    * @brief Set whether restart files are written incrementally.
+    *
+    * When true, patch data that is unchanged since it was last written
+    * to the same restart directory is written as a reference to the
+    * restart holding it.  The first restart written after this is set,
+    * after a restart is read, or to a new directory is complete.
+    * Unchanged data keeps referencing the restore that first wrote it,
+    * so earlier restores of the directory must not be deleted.
+    *
+    * This must be set to the same value on all processes.
+    */
+   void
+   setIncrementalRestartWrites(
+      const bool incremental_writes)
+   {
+      d_incremental_restart_writes = incremental_writes;
+   }
+
+   /*!
+    * @brief Return true if restart files are written incrementally.
+    */
+   bool
+   getIncrementalRestartWrites() const
+   {
+      return d_incremental_restart_writes;
+   }
+
+   /*!
+    * @brief Set whether restart files are written as mapped files.
+    *
+    * When true, each process writes its restart data as a packed
+    * MessageStream file, which openRestartFile() reads lazily.  Mapped
+    * files are read on the same architecture only, and are not used
+    * when the restart files are aggregated (see
+    * setNumberOfRestartWriters()).  Mapped files are recognized when
+    * reading regardless of this setting.
+    *
+    * This must be set to the same value on all processes.
+    */
+   void
+   setMappedRestartFiles(
+      const bool mapped_files)
+   {
+      d_mapped_restart_files = mapped_files;
+   }
+
+   /*!
+    * @brief Return true if restart files are written as mapped files.
+    */
+   bool
+   getMappedRestartFiles() const
+   {
+      return d_mapped_restart_files;
+   }
+
+   /*!
+    * @brief Return the restore number of the restart being written, or
+    * -1 when no numbered restart is being written.
+    */
+   int
+   getWriteRestoreNumber() const
+   {
+      return d_write_restore_num;
+   }
+
+   /*!
+    * @brief Return the root directory of the restart being written.
+    */
+   const std::string&
+   getWriteDirname() const
+   {
+      return d_write_dirname;
+   }
+
+   /*!
+    * @brief Write the restart data of all registered objects to a
+    * checkpoint in memory, replacing the previous memory checkpoint.
+    *
+    * The restart data of each process is serialized and kept by the
+    * process, and a copy is sent to its buddy process (see
+    * getCheckpointBuddy()).  No files are written.
+    *
+    * This is collective over all processes.
+    */
+   void
+   writeMemoryCheckpoint();
+
+   /*!
+    * @brief Make the last memory checkpoint the root database.
+    *
+    * The root database then is a MemoryDatabase holding the restart data
+    * of this process as it was at writeMemoryCheckpoint(), and is closed
+    * with closeRestartFile() as after openRestartFile().  The registered
+    * objects are not reset by this call: Serializable has no method to
+    * read restart data after construction, so each object whose state
+    * must roll back has to be reset from the root database by the
+    * application (see algs::TimeRefinementIntegrator::resetFromRestart(),
+    * which resets the integrator and its hierarchy).  A process that
+    * passes lost_local_copy = true, such as a process whose state may be
+    * corrupt, gets its data from the copy held by its buddy; a process
+    * and its buddy must not both lose their copies.
+    *
+    * This is collective over all processes.
+    *
+    * @param lost_local_copy  Whether to use the copy held by the buddy
+    *
+    * @pre hasMemoryCheckpoint()
+    */
+   void
+   openMemoryCheckpoint(
+      const bool lost_local_copy = false);
+
+   /*!
+    * @brief Return true if a memory checkpoint has been written.
+    */
+   bool
+   hasMemoryCheckpoint() const
+   {
+      return d_checkpoint_buddy >= 0;
+   }
+
+   /*!
+    * @brief Return the rank of the process holding the copy of the
+    * memory checkpoint of this process, or -1 before the first memory
+    * checkpoint.
+    *
+    * The buddy of each process is chosen from the node map of NodeGroup
+    * so that it is on another node unless one node holds more than half
+    * of the processes.
+    */
+   int
+   getCheckpointBuddy() const
+   {
+      return d_checkpoint_buddy;
+   }
+
 protected:
    /**
     * The constructor for RestartManager is protected.
@@ -292,6 +600,149 @@ private:
    writeRestartFile(
       const std::shared_ptr<Database>& database);
 
+   /*
+    * Write the restart data of all processes to the aggregated files in
+    * restart_dirname.
+    */
+   void
+   writeAggregatedRestartFile(
+      const std::string& restart_dirname);
+
+   /*
+    * Read the restart data of this process from the aggregated files in
+    * restart_dirname, written by num_nodes processes, into a
+    * MemoryDatabase and make it the root database.  num_nodes must be
+    * the number of processes reading the files; otherwise
+    * openRedistributedRestartFile() reads them.
+    */
+   void
+   openAggregatedRestartFile(
+      const std::string& restart_dirname,
+      const int num_nodes);
+
+   /*
+    * Read the restart files written by num_nodes processes in
+    * restart_dirname that are assigned to this process and merge them
+    * into a MemoryDatabase used as the root database.
+    */
+   void
+   openRedistributedRestartFile(
+      const std::string& root_dirname,
+      const std::string& restart_dirname,
+      const int num_nodes);
+
+   /*
+    * Return db with the references of an incremental restart written by
+    * writer_rank replaced by the referenced data of the restarts of
+    * root_dirname written by num_nodes processes, or db itself if it is
+    * not from an incremental restart.
+    */
+   std::shared_ptr<Database>
+   resolveIncrementalRestart(
+      const std::shared_ptr<Database>& db,
+      const std::string& root_dirname,
+      const int num_nodes,
+      const int writer_rank);
+
+   /*
+    * Copy src, at path in the restart database, into dst while resolving
+    * references.  The restart databases opened for references are kept
+    * in reference_dbs by restore number.
+    */
+   void
+   resolveIncrementalDatabases(
+      Database& dst,
+      const std::shared_ptr<Database>& src,
+      std::vector<std::string>& path,
+      std::map<int, std::shared_ptr<Database> >& reference_dbs,
+      const std::string& root_dirname,
+      const int num_nodes,
+      const int writer_rank);
+
+   /*
+    * Open the restart file of one process, either a mapped file or
+    * through the database factory.  Return a null pointer if the file
+    * cannot be opened.
+    */
+   std::shared_ptr<Database>
+   openProcessRestartFile(
+      const std::string& restart_filename);
+
+   /*
+    * Open restart_filename as a mapped restart file.  Return a null
+    * pointer if it is not one.
+    */
+   static std::shared_ptr<Database>
+   openMappedRestartFile(
+      const std::string& restart_filename);
+
+   /*
+    * Write the packed restart data in stream as a mapped restart file.
+    */
+   static void
+   writeMappedRestartFile(
+      const std::string& restart_filename,
+      const MessageStream& stream);
+
+   /*
+    * Open the restart database of writer_rank in restart_dirname, which
+    * holds either one file per process or aggregated files.
+    */
+   std::shared_ptr<Database>
+   openWriterRestartDatabase(
+      const std::string& restart_dirname,
+      const int writer_rank);
+
+   /*
+    * Merge the restart databases src_dbs read by this process into dst.
+    * Data outside of patch levels is copied from global_db.
+    */
+   static void
+   mergeRestartDatabases(
+      Database& dst,
+      const std::shared_ptr<Database>& global_db,
+      const std::vector<std::shared_ptr<Database> >& src_dbs,
+      const int rank,
+      const int nprocs);
+
+   /*
+    * Merge the restart databases of one patch level into dst, renumbering
+    * the boxes and patches of src_levels and giving them to rank.
+    */
+   static void
+   mergePatchLevelDatabases(
+      Database& dst,
+      const std::shared_ptr<Database>& global_level,
+      const std::vector<std::shared_ptr<Database> >& src_levels,
+      const int rank,
+      const int nprocs);
+
+   /*
+    * Write the packed streams of an aggregated group file as bytes.  An
+    * HDFDatabase stores them as an unsigned char dataset, other
+    * databases as a char array.
+    */
+   static void
+   putGroupStreams(
+      Database& group_db,
+      const std::vector<char>& streams);
+
+   /*
+    * Read the packed streams written by putGroupStreams().
+    */
+   static std::vector<char>
+   getGroupStreams(
+      Database& group_db);
+
+   /*
+    * Copy the non-database entry key of src to dst.
+    */
+   static void
+   copyRestartKey(
+      Database& dst,
+      Database& src,
+      const std::string& key);
+
    /*
     * Create the directory structure for the data files.
     * The directory structure created is
@@ -299,13 +750,38 @@ private:
     *   restart_dirname/
     *     restore.[restore number]/
     *       nodes.[number of processors]/
-    *         proc.[processor number]
+    *         proc.[processor number]   (or group.[group number] and index)
     */
    std::string
    createDirs(
       const std::string& root_dirname,
       int restore_num);
 
+   /*
+    * Choose the checkpoint buddy of this process, and the partner process
+    * whose memory checkpoint this process holds.
+    */
+   void
+   findCheckpointBuddy();
+
+   /*
+    * Run the function writing restart files, on the helper thread if
+    * asynchronous writes are enabled and the function may run there,
+    * and immediately otherwise.  uses_database_factory says whether the
+    * function writes through d_database_factory.
+    */
+   void
+   startRestartWrite(
+      const std::function<void()>& write,
+      const bool uses_database_factory);
+
+   /*
+    * Whether databases from d_database_factory may be written on the
+    * helper thread while the application uses the same I/O library.
+    */
+   bool
+   databaseFactoryIsThreadSafe() const;
+
    struct RestartItem {
       std::string name;
       Serializable* obj;
@@ -336,6 +812,54 @@ private:
 
    bool d_is_from_restart;
 
+   bool d_is_redistributed_restart;
+
+   /*
+    * Number of restart writer processes, 0 for one file per process.
+    */
+   int d_num_restart_writers;
+
+   /*
+    * Whether restart files are written on a helper thread, and that
+    * thread while a write is in progress.
+    */
+   bool d_async_restart_writes;
+   std::thread d_write_thread;
+
+   /*
+    * Whether patch data is written incrementally, and the directory and
+    * restore number of the restart being written.
+    */
+   bool d_incremental_restart_writes;
+   std::string d_write_dirname;
+   int d_write_restore_num;
+
+   /*
+    * Whether restart files are written as mapped files.
+    */
+   bool d_mapped_restart_files;
+
+   /*
+    * The serialized memory checkpoint of this process and the copy held
+    * for the partner, and the ranks of the buddy and of the partner.
+    */
+   std::vector<char> d_memory_checkpoint;
+   std::vector<char> d_partner_checkpoint;
+   int d_checkpoint_buddy;
+   int d_checkpoint_partner;
+
+   /*
+    * Message tags for sending restart streams to and from the writers.
+    */
+   static const int s_restart_size_tag;
+   static const int s_restart_data_tag;
+   static const int s_checkpoint_tag;
+
+   /*
+    * Leading bytes of a mapped restart file.
+    */
+   static const char s_mapped_file_magic[8];
+
    static StartupShutdownManager::Handler s_shutdown_handler;
 };
 
@@ -63,7 +63,10 @@ enum {
    MPI_MAXLOC,
    MPI_SUM,
    // Attributes:
-   MPI_TAG_UB
+   MPI_TAG_UB,
+   // Thread support levels:
+   MPI_THREAD_SINGLE,
+   MPI_THREAD_MULTIPLE
 };
 #endif
 
@@ -395,6 +398,10 @@ public:
    Finalized(
       int* flag);
 
+   static int
+   Query_thread(
+      int* provided);
+
    static int
    Get_count(
       Status* status,
@@ -498,6 +505,21 @@ public:
       Datatype datatype,
       Op op) const;
 
+   /*!
+    * @brief Non-blocking MPI Allreduce.
+    *
+    * The reduction is complete when the request has been waited on.
+    * The buffers must not be touched until then.
+    */
+   int
+   Iallreduce(
+      void* sendbuf,
+      void* recvbuf,
+      int count,
+      Datatype datatype,
+      Op op,
+      Request* request) const;
+
    int
    Attr_get(
       int keyval,
@@ -524,6 +546,24 @@ public:
    Comm_dup(
       Comm* newcomm) const;
 
+   int
+   Comm_split(
+      int color,
+      int key,
+      Comm* newcomm) const;
+
+   /*!
+    * @brief MPI Comm_split_type with MPI_COMM_TYPE_SHARED, splitting
+    * the communicator into groups of processes that can share memory.
+    *
+    * If the MPI implementation predates MPI-3, each process is put in
+    * its own group.
+    */
+   int
+   Comm_split_type_shared(
+      int key,
+      Comm* newcomm) const;
+
    /*!
     * @brief MPI Comm_rank (Set rank to 0 when MPI is disabled).
     */
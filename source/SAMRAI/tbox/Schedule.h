@@ -16,12 +16,14 @@
 #include "SAMRAI/tbox/AsyncCommStage.h"
 #include "SAMRAI/tbox/SAMRAI_MPI.h"
 #include "SAMRAI/tbox/MessageStream.h"
+#include "SAMRAI/tbox/NodeGroup.h"
 #include "SAMRAI/tbox/Transaction.h"
 
 #include <iostream>
 #include <map>
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace tbox {
@@ -48,7 +50,96 @@ namespace tbox {
  * order of transaction execution matters.  The transactions will be
  * executed in the order in which they appear in the list.
  *
+ * Optionally, messages between processes on different compute nodes
+ * can be aggregated through one leader process per node (see
+ * setNodeAggregation()).  Each process sends all of its off-node
+ * messages to its node leader in one bundle.  The leader forwards one
+ * message per destination node to that node's leader, which splits
+ * the incoming data by destination process and delivers one bundle to
+ * each.  Messages between processes on the same node are sent
+ * directly, as without aggregation.  This trades an extra on-node hop
+ * for far fewer inter-node messages when many processes share a node
+ * and communicate with the same remote nodes.
+ *
+ * Optionally, messages between processes on the same node can bypass
+ * MPI (see setSharedMemoryTransport()).  The sender packs each such
+ * message into a slot in an MPI-3 shared memory window, and the
+ * receiver unpacks straight from that slot, with flags in the slot
+ * signalling when data is ready and when it has been consumed.  This
+ * removes the receive-side copy and MPI message matching for on-node
+ * traffic.  Only messages whose size the receiver can compute use
+ * this transport; the others still go through MPI.
+ *
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *    - \b enable_node_aggregation
+ *       Default for setNodeAggregation() in new schedules.
+ *
+ *    - \b enable_shared_memory_transport
+ *       Default for setSharedMemoryTransport() in new schedules.
+ *
+ *    - \b DEV_emulated_node_size
+ *       If positive, group consecutive ranks into nodes of this size
+ *       for node aggregation and shared memory transport instead of
+ *       using the hardware nodes.  Intended for testing on a single
+ *       node.  With the shared memory transport, emulated nodes must
+ *       not span hardware nodes.
+ *
+ *    - \b DEV_shared_memory_segment_size
+ *       Bytes of shared memory each process contributes to the node
+ *       window holding shared memory message slots.  Messages that do
+ *       not fit go through MPI.
+ *
+ * All input parameters are read from the "Schedule" database of the
+ * input file, once, when the first schedule is constructed.
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>enable_node_aggregation</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>enable_shared_memory_transport</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>DEV_emulated_node_size</td>
+ *     <td>int</td>
+ *     <td>0</td>
+ *     <td>>=0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>DEV_shared_memory_segment_size</td>
+ *     <td>int</td>
+ *     <td>8388608</td>
+ *     <td>>=0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ * </table>
+ *
  * @see Transaction
+ * @see NodeGroup
  */
 
 class Schedule
@@ -248,6 +339,71 @@ public:
       d_unpack_in_deterministic_order = flag;
    }
 
+   /*!
+    * @brief Set whether to aggregate off-node messages through node
+    * leaders.
+    *
+    * The aggregation plan is set up on the first communication after
+    * aggregation is enabled.  That setup is collective over the
+    * processes sharing a node, and every execution of an aggregated
+    * schedule involves the node leaders, so all processes in the
+    * schedule's communicator must execute the schedule together, even
+    * those with no transactions.  Transactions with off-node peers
+    * may not be added once the plan is set up.
+    *
+    * Changing this flag is only allowed between communications.
+    *
+    * @param [in] flag
+    *
+    * @pre !allocatedCommunicationObjects()
+    */
+   void
+   setNodeAggregation(
+      bool flag);
+
+   /*!
+    * @brief Whether off-node messages are aggregated through node
+    * leaders.
+    */
+   bool
+   getNodeAggregation() const
+   {
+      return d_node_aggregation;
+   }
+
+   /*!
+    * @brief Set whether to send messages between processes on the
+    * same node through shared memory instead of MPI.
+    *
+    * The shared memory slots are set up on the first communication
+    * after the transport is enabled.  That setup is collective over
+    * the processes sharing a node, so all processes in the schedule's
+    * communicator must execute the schedule together, and transactions
+    * with on-node peers may not be added once the slots are set up.
+    * A sender waits in beginCommunication() until the receiver has
+    * unpacked the previous message in the same slot.
+    *
+    * The transport is unused if MPI-3 shared memory is not available.
+    * Changing this flag is only allowed between communications.
+    *
+    * @param [in] flag
+    *
+    * @pre !allocatedCommunicationObjects()
+    */
+   void
+   setSharedMemoryTransport(
+      bool flag);
+
+   /*!
+    * @brief Whether messages between processes on the same node go
+    * through shared memory.
+    */
+   bool
+   getSharedMemoryTransport() const
+   {
+      return d_shm_transport;
+   }
+
    /*!
     * @brief Setup names of timers.
     *
@@ -275,7 +431,7 @@ public:
    bool
    allocatedCommunicationObjects()
    {
-      return d_coms != 0;
+      return d_coms != 0 || d_agg_coms != 0;
    }
 
    /*!
@@ -297,6 +453,11 @@ private:
          delete[] d_coms;
       }
       d_coms = 0;
+      if (d_agg_coms) {
+         delete[] d_agg_coms;
+      }
+      d_agg_coms = 0;
+      d_agg_own_bundle.reset();
    }
 
    void
@@ -310,6 +471,127 @@ private:
    void
    deallocateSendBuffers();
 
+   /*!
+    * @brief Set up the node aggregation plan.
+    *
+    * Moves transaction sets with off-node peers into the aggregated
+    * sets and, on node leaders, gathers which node members send and
+    * receive aggregated data and from and to which nodes.  Collective
+    * over the node communicator.
+    */
+   void
+   setupNodeAggregation();
+
+   /*!
+    * @brief Undo setupNodeAggregation(), returning the aggregated
+    * sets to the direct sets.
+    */
+   void
+   clearNodeAggregation();
+
+   /*!
+    * @brief Error if a transaction with the given peer cannot be added
+    * because the aggregation plan or the shared memory slots are
+    * already set up.
+    */
+   void
+   checkNodeTransportPlans(
+      int peer) const;
+
+   /*!
+    * @brief Allocate the communication objects for aggregated
+    * messages.
+    */
+   void
+   allocateAggregationObjects();
+
+   /*!
+    * @brief Pack the local off-node messages into a bundle and post the
+    * aggregation receives and sends that can start immediately.
+    */
+   void
+   postAggregatedMessages();
+
+   /*!
+    * @brief Complete the aggregated communication, forwarding bundles
+    * on node leaders and unpacking aggregated data for the local
+    * process.
+    */
+   void
+   processAggregatedMessages();
+
+   /*!
+    * @brief Set up the shared memory transport.
+    *
+    * Allocates a slot in the local segment of the node's shared memory
+    * window for each on-node peer whose messages the receiver can size,
+    * moves the corresponding transaction sets into the shared memory
+    * sets and tells each receiver where its slots are.  Collective over
+    * the node communicator.
+    */
+   void
+   setupSharedMemoryTransport();
+
+   /*!
+    * @brief Undo setupSharedMemoryTransport(), returning the slots to
+    * the window and the shared memory sets to the direct sets.
+    */
+   void
+   clearSharedMemoryTransport();
+
+   /*!
+    * @brief Pack outgoing on-node messages into their shared memory
+    * slots.
+    */
+   void
+   postSharedMemorySends();
+
+   /*!
+    * @brief Unpack incoming on-node messages from the senders' shared
+    * memory slots.
+    */
+   void
+   processSharedMemoryReceives();
+
+   /*!
+    * @brief Wait until the receivers have consumed the last message in
+    * each outgoing slot.
+    */
+   void
+   waitForSharedMemorySlots() const;
+
+   /*!
+    * @brief Let MPI progress outstanding messages while spinning on a
+    * shared memory flag.
+    *
+    * The peer being waited on may itself be blocked on a message to or
+    * from this process, and many MPI implementations only progress
+    * messages from inside MPI calls.
+    */
+   void
+   progressWhileWaiting() const;
+
+   /*!
+    * @brief Leader method: split a bundle of sub-messages by the node
+    * (or, for inbound data, the node-local rank) of their destinations
+    * and append them to the corresponding streams.
+    */
+   void
+   routeBundle(
+      const char* data,
+      size_t num_bytes,
+      bool by_destination_node,
+      std::map<int, std::shared_ptr<MessageStream> >& streams) const;
+
+   /*!
+    * @brief Unpack a bundle of sub-messages addressed to the local
+    * process, in the order of their source ranks.
+    */
+   void
+   unpackBundle(
+      const char* data,
+      size_t num_bytes);
+
    Schedule(
       const Schedule&);                 // not implemented
    Schedule&
@@ -344,6 +626,20 @@ private:
    TransactionSets d_send_sets;
    TransactionSets d_recv_sets;
 
+   /*
+    * @brief Transactions with off-node peers, communicated through
+    * node leaders when node aggregation is set up.
+    */
+   TransactionSets d_agg_send_sets;
+   TransactionSets d_agg_recv_sets;
+
+   /*
+    * @brief Transactions with on-node peers, communicated through
+    * shared memory when the shared memory transport is set up.
+    */
+   TransactionSets d_shm_send_sets;
+   TransactionSets d_shm_recv_sets;
+
    /*
     * @brief Transactions where the source and destination are the
     * local process.
@@ -400,6 +696,146 @@ private:
     */
    bool d_unpack_in_deterministic_order;
 
+   //@{ @name Node aggregation
+
+   /*!
+    * @brief Whether to aggregate off-node messages.
+    *
+    * @see setNodeAggregation()
+    */
+   bool d_node_aggregation;
+
+   /*!
+    * @brief Whether the aggregation plan is set up.
+    */
+   bool d_agg_planned;
+
+   /*!
+    * @brief Node grouping of d_mpi, set up with the aggregation plan.
+    */
+   std::shared_ptr<NodeGroup> d_node_group;
+
+   /*!
+    * @brief Leader data: node-local ranks of the members (other than
+    * the leader) sending bundles to the leader.
+    */
+   std::vector<int> d_agg_bundle_senders;
+
+   /*!
+    * @brief Leader data: node-local ranks of the members (other than
+    * the leader) receiving aggregated data.
+    */
+   std::vector<int> d_agg_bundle_receivers;
+
+   /*!
+    * @brief Leader data: nodes sending aggregated data to this node.
+    */
+   std::vector<int> d_agg_src_nodes;
+
+   /*!
+    * @brief Leader data: nodes receiving aggregated data from this
+    * node.
+    */
+   std::vector<int> d_agg_dst_nodes;
+
+   /*!
+    * @brief Aggregation communication objects.
+    *
+    * On leaders, these are the bundle receives from members, the
+    * receives from source leaders, the sends to destination leaders
+    * and the bundle sends to members, in that order.  On other
+    * processes, the bundle receive from the leader (if any) is
+    * followed by the bundle send to the leader (if any).
+    */
+   AsyncCommPeer<char>* d_agg_coms;
+
+   /*!
+    * @brief Stage for advancing aggregation communication.
+    */
+   AsyncCommStage d_agg_stage;
+
+   /*!
+    * @brief Leader data: the leader's own bundle of off-node messages.
+    */
+   std::shared_ptr<MessageStream> d_agg_own_bundle;
+
+   //@}
+
+   //@{ @name Shared memory transport
+
+   /*!
+    * @brief Location of a message slot in the shared memory window.
+    *
+    * A slot starts with a header of flags (see s_shm_header_size)
+    * followed by room for d_capacity bytes of message data.
+    */
+   struct SharedMemorySlot {
+      SharedMemorySlot():
+         d_node_rank(-1),
+         d_offset(0),
+         d_capacity(0) {
+      }
+      SharedMemorySlot(
+         int node_rank,
+         size_t offset,
+         size_t capacity):
+         d_node_rank(node_rank),
+         d_offset(offset),
+         d_capacity(capacity) {
+      }
+      //! @brief Node-local rank of the process owning the slot (the sender).
+      int d_node_rank;
+      //! @brief Offset of the slot in the owner's segment.
+      size_t d_offset;
+      //! @brief Bytes of message data the slot can hold.
+      size_t d_capacity;
+   };
+
+   /*!
+    * @brief Whether to use the shared memory transport.
+    *
+    * @see setSharedMemoryTransport()
+    */
+   bool d_shm_transport;
+
+   /*!
+    * @brief Whether the shared memory slots are set up.
+    */
+   bool d_shm_planned;
+
+   /*!
+    * @brief Shared memory window holding the slots.
+    */
+   std::shared_ptr<SharedMemoryWindow> d_shm_window;
+
+   /*!
+    * @brief Outgoing slots, keyed on the receiver's rank.
+    */
+   std::map<int, SharedMemorySlot> d_shm_send_slots;
+
+   /*!
+    * @brief Incoming slots, keyed on the sender's rank.
+    */
+   std::map<int, SharedMemorySlot> d_shm_recv_slots;
+
+   /*!
+    * @brief Number of communications since the slots were set up.
+    *
+    * Slot flags hold the sequence number of the last message written
+    * and consumed.
+    */
+   long long d_shm_sequence;
+
+   /*!
+    * @brief Bytes reserved for flags at the start of each slot.
+    *
+    * The flags are the sequence numbers of the last message written
+    * and last message consumed, and the byte count of the message.
+    */
+   static const size_t s_shm_header_size;
+
+   //@}
+
    static const int s_default_first_tag;
    static const int s_default_second_tag;
    static const size_t s_default_first_message_length;
@@ -427,6 +863,8 @@ private:
       std::shared_ptr<Timer> t_pack_stream;
       std::shared_ptr<Timer> t_unpack_stream;
       std::shared_ptr<Timer> t_local_copies;
+      std::shared_ptr<Timer> t_node_aggregation;
+      std::shared_ptr<Timer> t_shared_memory;
    };
 
    //! @brief Default prefix for Timers.
@@ -439,6 +877,27 @@ private:
 
    static char s_ignore_external_timer_prefix;
 
+   /*!
+    * @brief Default for d_node_aggregation, from input.
+    */
+   static bool s_default_node_aggregation;
+
+   /*!
+    * @brief Emulated node size for node aggregation, from input.
+    */
+   static int s_emulated_node_size;
+
+   /*!
+    * @brief Default for d_shm_transport, from input.
+    */
+   static bool s_default_shm_transport;
+
+   /*!
+    * @brief Bytes each process contributes to the shared memory
+    * window, from input.
+    */
+   static size_t s_shm_segment_size;
+
    /*!
     * @brief Structure of timers in s_static_timers, matching this
     * object's timer prefix.
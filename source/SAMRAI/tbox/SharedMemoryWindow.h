@@ -0,0 +1,181 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2019 Lawrence Livermore National Security, LLC
+ * Description:   Memory shared by the processes of a node
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_SharedMemoryWindow
+#define included_tbox_SharedMemoryWindow
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+
+#include <map>
+#include <vector>
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Class SharedMemoryWindow manages an MPI-3 shared-memory
+ * window over the processes of a node communicator.
+ *
+ * Each process contributes a segment of fixed size, and every process
+ * can address every segment directly.  A process sub-allocates blocks
+ * from its own segment with allocate() and deallocate(), without
+ * communication; peers learn the block offsets by other means.
+ *
+ * The window is held in a passive-target epoch for its whole life, so
+ * processes synchronize through flags in the shared memory itself,
+ * using sync() as the memory barrier around flag updates.
+ *
+ * Shared memory windows need MPI-3.  Use isAvailable() to check before
+ * constructing a window.
+ */
+class SharedMemoryWindow
+{
+public:
+   /*!
+    * @brief Value returned by allocate() when there is no room.
+    */
+   static const size_t s_invalid_offset;
+
+   /*!
+    * @brief Allocate the window.
+    *
+    * This is collective over node_mpi, whose processes must share a
+    * memory domain.
+    *
+    * @param[in] node_mpi
+    * @param[in] segment_size  Bytes contributed by the local process.
+    *
+    * @pre isAvailable()
+    */
+   SharedMemoryWindow(
+      const SAMRAI_MPI& node_mpi,
+      size_t segment_size);
+
+   /*!
+    * @brief Free the window.
+    *
+    * This is collective over the node communicator unless MPI has
+    * already been finalized.
+    */
+   ~SharedMemoryWindow();
+
+   /*!
+    * @brief Whether shared memory windows are supported by this build
+    * and run.
+    */
+   static bool
+   isAvailable();
+
+   /*!
+    * @brief Return the start of the segment of the given node-local
+    * rank.
+    */
+   char *
+   getSegment(
+      int node_rank) const
+   {
+      TBOX_ASSERT(node_rank >= 0 &&
+         node_rank < static_cast<int>(d_segments.size()));
+      return d_segments[node_rank];
+   }
+
+   /*!
+    * @brief Return the size of the segment of the given node-local
+    * rank.
+    */
+   size_t
+   getSegmentSize(
+      int node_rank) const
+   {
+      TBOX_ASSERT(node_rank >= 0 &&
+         node_rank < static_cast<int>(d_segment_sizes.size()));
+      return d_segment_sizes[node_rank];
+   }
+
+   /*!
+    * @brief Allocate a block of the local segment.
+    *
+    * Blocks are aligned to 64 bytes.
+    *
+    * @return Offset of the block in the local segment, or
+    * s_invalid_offset if the segment has no room.
+    */
+   size_t
+   allocate(
+      size_t num_bytes);
+
+   /*!
+    * @brief Return a block obtained from allocate() to the local
+    * segment.
+    */
+   void
+   deallocate(
+      size_t offset);
+
+   /*!
+    * @brief Synchronize the public and private copies of the window.
+    *
+    * Acts as a memory barrier between writes and reads of shared data.
+    */
+   void
+   sync() const;
+
+private:
+   SharedMemoryWindow(
+      const SharedMemoryWindow&);       // not implemented
+   SharedMemoryWindow&
+   operator = (
+      const SharedMemoryWindow&);       // not implemented
+
+   /*!
+    * @brief Alignment of allocated blocks.
+    */
+   static const size_t s_alignment;
+
+   /*!
+    * @brief The node communicator (not owned).
+    */
+   SAMRAI_MPI d_node_mpi;
+
+#if defined(HAVE_MPI) && MPI_VERSION >= 3
+   /*!
+    * @brief The MPI window.
+    */
+   MPI_Win d_win;
+#endif
+
+   /*!
+    * @brief Start of each process's segment.
+    */
+   std::vector<char *> d_segments;
+
+   /*!
+    * @brief Size of each process's segment.
+    */
+   std::vector<size_t> d_segment_sizes;
+
+   /*!
+    * @brief Free blocks of the local segment, offset to size.
+    */
+   std::map<size_t, size_t> d_free_blocks;
+
+   /*!
+    * @brief Allocated blocks of the local segment, offset to size.
+    */
+   std::map<size_t, size_t> d_used_blocks;
+
+};
+
+}
+}
+
+#endif
@@ -20,12 +20,16 @@
 #include "SAMRAI/hier/TimeInterpolateOperator.h"
 #include "SAMRAI/xfer/VariableFillPattern.h"
 #include "SAMRAI/hier/Connector.h"
+#include "SAMRAI/hier/MappingConnector.h"
 #include "SAMRAI/hier/Box.h"
 #include "SAMRAI/hier/BoxLevel.h"
 #include "SAMRAI/hier/PatchHierarchy.h"
 #include "SAMRAI/hier/PatchLevel.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
 
 #include <memory>
+#include <typeinfo>
+#include <vector>
 
 namespace SAMRAI {
 namespace xfer {
@@ -112,6 +116,51 @@ namespace xfer {
  * as long as the patches involved in the communication process do not change;
  * thus, they can be used for multiple data communication cycles.
  *
+ * Applications often create several schedules for the same levels from
+ * different refine algorithms whose items differ only in the patch data
+ * ids, for example for the current, old and new data of an integrator.
+ * When schedule skeleton sharing is enabled, createSchedule() looks for
+ * a live schedule built for the same configuration (levels, hierarchy,
+ * fill pattern type and behavior, patch strategy, transaction factory
+ * and time interpolation flag) from equivalent refine items whose
+ * variable fill patterns agree in name and stencil width, and if one
+ * exists, the new schedule shares its transactions, coarse interpolation
+ * levels and overlaps instead of recomputing them.  See the
+ * skeleton-sharing RefineSchedule constructor for the restrictions this
+ * places on the schedules.  Only schedules created with the default
+ * transaction factory or with the same transaction factory object are
+ * shared.
+ *
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *    - \b share_schedule_skeletons
+ *       Whether createSchedule() shares schedule skeletons between
+ *       schedules of matching configuration.
+ *
+ * All input parameters are read from the "RefineAlgorithm" database of
+ * the input file, once, when the first schedule is created.
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>share_schedule_skeletons</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ * </table>
+ *
  * @see RefineSchedule
  * @see RefinePatchStrategy
  * @see RefineClasses
@@ -594,6 +643,39 @@ public:
       const std::shared_ptr<RefineTransactionFactory>& transaction_factory =
          std::shared_ptr<RefineTransactionFactory>());
 
+   /*!
+    * @brief Create a communication schedule for a regridded level from
+    * the schedule of the level it replaced.
+    *
+    * The new schedule fills the new level in the same way old_schedule
+    * filled the old one, using the same fill pattern, next coarser level
+    * number, patch strategy, time interpolation flag and transaction
+    * factory.  Overlaps retained by old_schedule for pairs of boxes left
+    * unchanged by the regrid are reused.  See the corresponding
+    * RefineSchedule constructor for details.
+    *
+    * @param[in] old_schedule  Schedule of the old level, created by a
+    *                          createSchedule() method taking a hierarchy
+    *                          with the destination level as source level
+    *                          or with no source level.
+    * @param[in] old_to_new  Mapping from the old level's box level to
+    *                        the new level's box level.
+    * @param[in] level  The new level.
+    * @param[in] hierarchy  std::shared_ptr to patch hierarchy.  May be
+    *                       null only when old_schedule has no next
+    *                       coarser level.
+    *
+    * @pre old_schedule
+    * @pre level
+    * @pre d_refine_classes->classesMatch(old_schedule->getEquivalenceClasses())
+    */
+   std::shared_ptr<RefineSchedule>
+   createSchedule(
+      const std::shared_ptr<RefineSchedule>& old_schedule,
+      const hier::MappingConnector& old_to_new,
+      const std::shared_ptr<hier::PatchLevel>& level,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy);
+
    /*!
     * @brief Given a previously-generated refine schedule, check for
     * consistency with this refine algorithm object to see whether a call to
@@ -680,6 +762,85 @@ private:
    operator = (
       const RefineAlgorithm&);                  // not implemented
 
+   /*!
+    * @brief Configuration of a schedule whose skeleton may be shared.
+    *
+    * Levels and the hierarchy are held weakly so that the registry does
+    * not extend their lives; an entry whose objects have expired no
+    * longer matches and is pruned.
+    */
+   struct ScheduleSkeleton {
+      std::weak_ptr<RefineSchedule> d_schedule;
+      const std::type_info* d_fill_pattern_type;
+      int d_fill_pattern_flags;
+      std::weak_ptr<hier::PatchLevel> d_dst_level;
+      std::weak_ptr<hier::PatchLevel> d_src_level;
+      bool d_has_src_level;
+      int d_next_coarser_level;
+      std::weak_ptr<hier::PatchHierarchy> d_hierarchy;
+      std::vector<std::weak_ptr<hier::PatchLevel> > d_coarser_levels;
+      bool d_recursive;
+      RefinePatchStrategy* d_patch_strategy;
+      std::weak_ptr<RefineTransactionFactory> d_transaction_factory;
+      bool d_use_time_refinement;
+   };
+
+   /*!
+    * @brief Construct a schedule, sharing the skeleton of a registered
+    * schedule when possible.
+    *
+    * This is the common implementation of the createSchedule() methods.
+    * With recursive false, the schedule only copies from src_level and
+    * next_coarser_level and hierarchy are ignored.
+    */
+   std::shared_ptr<RefineSchedule>
+   buildSchedule(
+      const std::shared_ptr<PatchLevelFillPattern>& fill_pattern,
+      const std::shared_ptr<hier::PatchLevel>& dst_level,
+      const std::shared_ptr<hier::PatchLevel>& src_level,
+      int next_coarser_level,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      bool recursive,
+      RefinePatchStrategy* patch_strategy,
+      bool use_time_refinement,
+      const std::shared_ptr<RefineTransactionFactory>& transaction_factory);
+
+   /*!
+    * @brief Whether a registered skeleton matches the given
+    * configuration.
+    */
+   bool
+   skeletonMatches(
+      const ScheduleSkeleton& skeleton,
+      const RefineSchedule& schedule,
+      const ScheduleSkeleton& config) const;
+
+   /*!
+    * @brief Whether the variable fill pattern of a refine item matches
+    * the one of the corresponding item of a skeleton.
+    *
+    * Patterns match if they are the same object, or have the same type,
+    * name and, except for the box geometry pattern, stencil width.
+    */
+   static bool
+   variableFillPatternsMatch(
+      const std::shared_ptr<VariableFillPattern>& pattern,
+      const std::shared_ptr<VariableFillPattern>& skeleton_pattern);
+
+   /*!
+    * @brief Read static data from input database.
+    */
+   static void
+   getFromInput();
+
+   /*!
+    * @brief Drop the registered schedule skeletons.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   finalizeCallback();
+
    /*!
     * RefineClasses object holds all of the registered refine items
     */
@@ -690,6 +851,24 @@ private:
     */
    bool d_schedule_created;
 
+   /*!
+    * @brief Whether to share schedule skeletons.
+    */
+   static bool s_share_schedule_skeletons;
+
+   /*!
+    * @brief Flag indicating whether input has been read.
+    */
+   static bool s_read_static_input;
+
+   /*!
+    * @brief Schedules whose skeletons may be shared, from all refine
+    * algorithms.
+    */
+   static std::vector<ScheduleSkeleton> s_schedule_skeletons;
+
+   static tbox::StartupShutdownManager::Handler s_finalize_handler;
+
 };
 
 }
@@ -20,13 +20,16 @@
 #include "SAMRAI/xfer/SingularityPatchStrategy.h"
 #include "SAMRAI/hier/ComponentSelector.h"
 #include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/hier/MappingConnector.h"
 #include "SAMRAI/hier/PatchHierarchy.h"
 #include "SAMRAI/hier/PatchLevel.h"
 #include "SAMRAI/tbox/Schedule.h"
 #include "SAMRAI/tbox/Timer.h"
 
 #include <iostream>
+#include <map>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace xfer {
@@ -62,6 +65,45 @@ namespace xfer {
  * - @c PatchLevelBorderAndInteriorFillPattern - Fill interior and
  *      ghosts on level borders.
  *
+ * After a regrid that changes only some of the boxes of a level, a
+ * schedule for the new level may be built from the schedule of the old
+ * level and the MappingConnector from the old level to the new one.
+ * When the old schedule retained its overlaps, the overlaps between
+ * pairs of boxes that the regrid left unchanged are reused rather than
+ * recomputed.  Overlaps are retained only when requested in the input,
+ * because they are otherwise released with the transactions.
+ *
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *    - \b retain_overlaps
+ *       Whether schedules created with a hierarchy keep the overlaps of
+ *       their transactions for reuse by a schedule of the regridded
+ *       level.
+ *
+ * All input parameters are read from the "RefineSchedule" database of
+ * the input file, once, when the first schedule is created.
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>retain_overlaps</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ * </table>
+ *
  * @see RefineAlgorithm
  * @see RefinePatchStrategy
  * @see RefineClasses
@@ -199,6 +241,87 @@ public:
       RefinePatchStrategy* patch_strategy,
       bool use_time_refinement = false);
 
+   /*!
+    * @brief Constructor that creates a refine schedule sharing the
+    * communication skeleton of an existing schedule.
+    *
+    * The skeleton is everything computed from the level configuration:
+    * the transactions, the coarse interpolation levels and their
+    * recursive schedules, the refine overlaps and the Connectors.  The
+    * new schedule shares these with the skeleton schedule and differs
+    * only in the refine items it operates on.  No communication is
+    * needed to construct it.
+    *
+    * The refine items must correspond one to one with the items of the
+    * skeleton schedule: item i of refine_classes must be equivalent to
+    * item i of the skeleton's classes and belong to the same
+    * equivalence class.  In general, this constructor is called by a
+    * RefineAlgorithm object, which checks that requirement.
+    *
+    * Schedules sharing a skeleton share their tbox::Schedule objects, so
+    * setDeterministicUnpackOrderingFlag() applies to all of them.  They
+    * also share internal levels, so at most one of them at a time may
+    * hold data allocated by allocateInternalData().
+    *
+    * @param[in] skeleton  Schedule whose skeleton is shared.
+    * @param[in] refine_classes  std::shared_ptr to structure containing
+    *                            patch data and operator information.
+    *
+    * @pre refine_classes
+    * @pre refine_classes->getNumberOfRefineItems() ==
+    *      skeleton.getEquivalenceClasses()->getNumberOfRefineItems()
+    */
+   RefineSchedule(
+      const RefineSchedule& skeleton,
+      const std::shared_ptr<RefineClasses>& refine_classes);
+
+   /*!
+    * @brief Constructor that creates a refine schedule for a regridded
+    * destination level from the schedule of the level it replaced.
+    *
+    * The new schedule has the configuration of old_schedule: fill
+    * pattern, next coarser level number, transaction factory, patch
+    * strategy and time interpolation flag.  If old_schedule copied from
+    * its own destination level, the new schedule copies from dst_level;
+    * if it had no source level, neither does the new schedule.
+    *
+    * The schedule is constructed as by the recursive constructor above,
+    * except that the overlap of a destination box, source box and fill
+    * box is taken from old_schedule when old_schedule retained its
+    * overlaps and computed the same overlap.  A local box changed by the
+    * regrid, i.e. one with a neighborhood in old_to_new, never reuses an
+    * overlap; the boxes of other processes are compared with the boxes
+    * the retained overlaps were computed for.  The transactions and the
+    * coarse interpolation schedules are always created anew, since they
+    * refer to the patches of the new level.
+    *
+    * In general, this constructor is called by a RefineAlgorithm object,
+    * which checks that refine_classes is consistent with the classes of
+    * old_schedule.
+    *
+    * @param[in] old_schedule  Schedule of the old destination level.
+    * @param[in] old_to_new  Mapping from the old destination box level
+    *                        to the new one.
+    * @param[in] dst_level  The new destination level.
+    * @param[in] hierarchy  std::shared_ptr to the patch hierarchy.  May
+    *                       be null only when old_schedule has no next
+    *                       coarser level.
+    * @param[in] refine_classes  std::shared_ptr to structure containing
+    *                            patch data and operator information.
+    *
+    * @pre old_schedule was created by the recursive constructor or by
+    *      this constructor
+    * @pre old_to_new.getBase() == *old_schedule's destination box level
+    * @pre old_to_new.getHead() == *dst_level->getBoxLevel()
+    * @pre refine_classes
+    */
+   RefineSchedule(
+      const RefineSchedule& old_schedule,
+      const hier::MappingConnector& old_to_new,
+      const std::shared_ptr<hier::PatchLevel>& dst_level,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const std::shared_ptr<RefineClasses>& refine_classes);
+
    /*!
     * Destructor for the schedule releases all internal storage.
     */
@@ -260,6 +383,33 @@ public:
       return d_refine_classes;
    }
 
+   /*!
+    * @brief Return the number of overlaps that this schedule, built for
+    * a regridded level, took from the schedule of the old level.
+    *
+    * Only overlaps of copies from the source level are counted.  The
+    * count is zero for schedules not built for a regridded level.
+    */
+   int
+   getNumberOfReusedOverlaps() const
+   {
+      return d_num_reused_overlaps;
+   }
+
+   /*!
+    * @brief Return the number of overlaps that this schedule, built for
+    * a regridded level, had to compute because the schedule of the old
+    * level had no matching overlap.
+    *
+    * Only overlaps of copies from the source level are counted.  The
+    * count is zero for schedules not built for a regridded level.
+    */
+   int
+   getNumberOfRecomputedOverlaps() const
+   {
+      return d_num_recomputed_overlaps;
+   }
+
    /*!
     * @brief Set whether to unpack messages in a deterministic order.
     *
@@ -410,6 +560,66 @@ private:
       RefinePatchStrategy* patch_strategy,
       const RefineSchedule* top_refine_schedule);
 
+   /*!
+    * @brief This private constructor implements the public recursive
+    * constructor and the constructor for regridded levels.
+    *
+    * @param[in] dst_level_fill_pattern
+    * @param[in] dst_level
+    * @param[in] src_level
+    * @param[in] next_coarser_level
+    * @param[in] hierarchy
+    * @param[in] refine_classes
+    * @param[in] transaction_factory
+    * @param[in] patch_strategy
+    * @param[in] use_time_refinement
+    * @param[in] old_schedule  Schedule whose retained overlaps may be
+    *                          reused, or null.
+    * @param[in] old_to_new  Mapping from the destination box level of
+    *                        old_schedule to that of dst_level.  Null if
+    *                        and only if old_schedule is null.
+    */
+   RefineSchedule(
+      const std::shared_ptr<PatchLevelFillPattern>& dst_level_fill_pattern,
+      const std::shared_ptr<hier::PatchLevel>& dst_level,
+      const std::shared_ptr<hier::PatchLevel>& src_level,
+      int next_coarser_level,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const std::shared_ptr<RefineClasses>& refine_classes,
+      const std::shared_ptr<RefineTransactionFactory>& transaction_factory,
+      RefinePatchStrategy* patch_strategy,
+      bool use_time_refinement,
+      const RefineSchedule* old_schedule,
+      const hier::MappingConnector* old_to_new);
+
+   /*!
+    * @brief This private constructor shares the skeleton of a schedule.
+    *
+    * It implements the public skeleton-sharing constructor and is
+    * called recursively for the coarse interpolation schedules.
+    *
+    * @param[in] skeleton
+    * @param[in] refine_classes
+    * @param[in] top_refine_schedule  Top schedule of the new schedule
+    *                                 tree, or null if the new schedule is
+    *                                 the top.
+    */
+   RefineSchedule(
+      const RefineSchedule& skeleton,
+      const std::shared_ptr<RefineClasses>& refine_classes,
+      const RefineSchedule* top_refine_schedule);
+
+   /*!
+    * @brief Build the refine classes of a coarse interpolation schedule
+    * sharing the skeleton of coarse_skeleton.
+    *
+    * The items are copies of this schedule's items with the variable
+    * fill patterns used by coarse_skeleton.
+    */
+   std::shared_ptr<RefineClasses>
+   createSharedCoarseInterpClasses(
+      const RefineSchedule& coarse_skeleton) const;
+
    /*!
     * @brief Read static data from input database.
     */
@@ -916,6 +1126,20 @@ private:
       const hier::Box& src_box,
       const bool use_time_interpolation);
 
+   /*!
+    * @brief Find the overlap retained by d_overlap_source for an
+    * equivalence class, destination box, source box and fill box.
+    *
+    * @return The retained overlap, or null if there is none or either
+    * box was changed by the regrid.
+    */
+   std::shared_ptr<hier::BoxOverlap>
+   findRetainedOverlap(
+      int equiv_class,
+      const hier::Box& dst_box,
+      const hier::Box& src_box,
+      const hier::Box& fill_box) const;
+
    /*!
     * @brief Reorder the neighborhood sets from a src_to_dst Connector
     * so they can be used in schedule generation.
@@ -968,6 +1192,17 @@ private:
    void
    clearRefineItems();
 
+   /*!
+    * @brief Point the refine item array at this schedule's items, here
+    * and in the coarse interpolation schedules.
+    *
+    * Transactions read the items through the array, which is shared by
+    * all schedules sharing a skeleton, so each schedule binds its own
+    * items before using the transactions.
+    */
+   void
+   bindRefineItems() const;
+
    /*!
     * @brief Utility function to check refine items to see whether their
     * patch data components have sufficient ghost width to handle
@@ -1004,8 +1239,21 @@ private:
     */
    size_t d_number_refine_items;
 
+   /*!
+    * @brief Storage of the refine item array, shared by all schedules
+    * sharing a skeleton.
+    */
+   struct RefineItemArray {
+      std::vector<const RefineClasses::Data *> d_items;
+      //! @brief Sharer currently holding allocateInternalData() data.
+      const RefineSchedule* d_internal_data_owner;
+   };
+   std::shared_ptr<RefineItemArray> d_refine_item_array;
+
    /*!
     * @brief used as array to store copy of refine data items.
+    *
+    * This points into d_refine_item_array.
     */
    const RefineClasses::Data** d_refine_items;
 
@@ -1283,6 +1531,80 @@ private:
 
    //@}
 
+   //@{
+
+   /*!
+    * @name Data members for building schedules of regridded levels
+    */
+
+   /*!
+    * @brief An overlap computed by constructScheduleTransactions() and
+    * the boxes it was computed for.
+    */
+   struct RetainedOverlap {
+      int d_equiv_class;
+      hier::Box d_dst_box;
+      hier::Box d_src_box;
+      hier::Box d_fill_box;
+      std::shared_ptr<hier::BoxOverlap> d_overlap;
+   };
+
+   /*!
+    * @brief Retained overlaps keyed by destination and source BoxId.
+    */
+   typedef std::map<std::pair<hier::BoxId, hier::BoxId>,
+                    std::vector<RetainedOverlap> > RetainedOverlapMap;
+
+   /*!
+    * @brief Overlaps of this schedule's transactions from d_src_level
+    * to d_dst_level, if retained.
+    *
+    * Only top schedules created with a hierarchy retain overlaps.
+    * Schedules sharing a skeleton share the map.
+    */
+   std::shared_ptr<RetainedOverlapMap> d_retained_overlaps;
+
+   /*!
+    * @brief Next coarser level number given to the constructor.
+    */
+   int d_next_coarser_ln;
+
+   /*!
+    * @brief Time interpolation flag given to the constructor.
+    */
+   bool d_use_time_refinement;
+
+   /*!
+    * @brief Whether this schedule was created with a hierarchy, so
+    * that a schedule for a regridded level can be built from it.
+    */
+   bool d_can_regenerate;
+
+   /*!
+    * @brief Schedule whose retained overlaps are reused, set only
+    * during construction.
+    */
+   const RefineSchedule* d_overlap_source;
+
+   /*!
+    * @brief Mapping from the destination box level of d_overlap_source
+    * to d_dst_level, set only during construction.
+    */
+   const hier::MappingConnector* d_old_to_new;
+
+   /*!
+    * @brief Number of overlaps taken from d_overlap_source.
+    */
+   int d_num_reused_overlaps;
+
+   /*!
+    * @brief Number of overlaps computed because d_overlap_source had
+    * none to reuse.
+    */
+   int d_num_recomputed_overlaps;
+
+   //@}
+
    /*!
     * @brief PatchLevelFillPattern controlling what parts of the destination
     * level can be filled.
@@ -1334,6 +1656,12 @@ private:
     */
    static bool s_barrier_and_time;
 
+   /*!
+    * @brief Whether schedules created with a hierarchy retain their
+    * overlaps.
+    */
+   static bool s_retain_overlaps;
+
    /*!
     * @brief Flag indicating if any RefineSchedule has read the input database
     * for static data.
@@ -138,10 +138,52 @@ public:
     * -# Set boundary conditions
     * -# Specify Poisson equation parameters
     * -# Call solver
+    *
+    * @return Whether the solver converged.
     */
-   int
+   bool
    solvePoisson();
 
+   /*!
+    * @brief Check that the solver picks up coefficients changed
+    * between two solves.
+    *
+    * Solves with D = 1 and C = 0, changes the coefficients to
+    * d_constant and c_constant and solves again without reinitializing
+    * the solver state, then solves with the new coefficients from a
+    * new solver state.  The two solves with the new coefficients should
+    * agree to within the solver tolerance.
+    *
+    * @param c_constant New value of C.
+    * @param d_constant New value of D.
+    *
+    * @return The maximum difference between the two solutions with the
+    * new coefficients, or a negative value if a solve did not converge.
+    */
+   double
+   checkCoefficientChange(
+      double c_constant,
+      double d_constant);
+
+   /*!
+    * @brief Return the number of iterations of the last solve.
+    */
+   int
+   getNumberOfIterations() const
+   {
+      return d_number_of_iterations;
+   }
+
+   /*!
+    * @brief Return the number of single precision FAC cycles of the
+    * last solve.
+    */
+   int
+   getNumberOfReducedPrecisionCycles() const
+   {
+      return d_number_of_reduced_precision_cycles;
+   }
+
 #ifdef HAVE_HDF5
    /*!
     * @brief Set up external plotter to plot internal
@@ -165,6 +207,12 @@ public:
 #endif
 
 private:
+   /*!
+    * @brief Set the initial guess of the solution to zero.
+    */
+   void
+   zeroSolution();
+
    std::string d_object_name;
 
    const tbox::Dimension d_dim;
@@ -206,6 +254,20 @@ private:
     */
    int d_comp_soln_id, d_exact_id, d_rhs_id;
 
+   /*!
+    * @brief Descriptor index of a solution saved by
+    * checkCoefficientChange().
+    *
+    * Allocated only while the check runs.
+    */
+   int d_saved_soln_id;
+
+   /*!
+    * @brief Number of iterations of the last solve.
+    */
+   int d_number_of_iterations;
+   int d_number_of_reduced_precision_cycles;
+
    //@}
 
 };
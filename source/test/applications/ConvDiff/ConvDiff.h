@@ -24,6 +24,7 @@
 #include "SAMRAI/algs/MethodOfLinesIntegrator.h"
 #include "SAMRAI/algs/MethodOfLinesPatchStrategy.h"
 #include "SAMRAI/hier/Patch.h"
+#include "SAMRAI/hier/PatchHierarchy.h"
 #include "SAMRAI/tbox/Serializable.h"
 #include <string>
 #define included_String
@@ -93,6 +94,7 @@ public:
    ///      initializeDataOnPatch(),
    ///      computeStableDtOnPatch(),
    ///      singleStep(),
+   ///      lowStorageStep(),
    ///      tagGradientDetectorCells(),
    ///      preprocessRefine(),
    ///      postprocessRefine(),
@@ -151,6 +153,18 @@ public:
       const double alpha_2,
       const double beta) const;
 
+   /**
+    * Perform one stage of a low-storage Runge-Kutta scheme, evaluating
+    * the right-hand side and then updating the stage increment and the
+    * solution in a single fused pass.
+    */
+   void
+   lowStorageStep(
+      hier::Patch& patch,
+      const double dt,
+      const double a,
+      const double b) const;
+
    /**
     * Tag cells which need refinement.
     */
@@ -287,6 +301,14 @@ public:
       std::shared_ptr<appu::VisItDataWriter> viz_writer);
 #endif
 
+   /**
+    * Return the L2 norm of the solution on level 0 of the hierarchy,
+    * weighted by the cell volume and summed over all processors.
+    */
+   double
+   computeSolutionNorm(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy) const;
+
    /**
     * Prints all class data members, if assertion is thrown.
     */
@@ -88,6 +88,26 @@ void SAMRAI_F77_FUNC(rkstep3d, RKSTEP3D) (
    const double *,
    const int&);
 
+void SAMRAI_F77_FUNC(lsrkstep2d, LSRKSTEP2D) (
+   const int&, const int&, const int&, const int&,
+   const int&, const int&,
+   const double&, const double&, const double&,
+   double *,
+   double *,
+   const double *,
+   const int&);
+
+void SAMRAI_F77_FUNC(lsrkstep3d, LSRKSTEP3D) (
+   const int&, const int&, const int&, const int&,
+   const int&, const int&,
+   const int&, const int&,
+   const int&,
+   const double&, const double&, const double&,
+   double *,
+   double *,
+   const double *,
+   const int&);
+
 void SAMRAI_F77_FUNC(tagcells2d, TAGCELLS2D) (
    const int&, const int&, const int&, const int&,
    const int&, const int&,
@@ -56,5 +56,72 @@ c
          end do
       end do
 
+      return
+      end
+c
+c***********************************************************************
+c Fused stage of a low-storage (2N) RK scheme: the stage increment and
+c the solution are updated in one pass,
+c    du = a*du + dt*rhs,   u = u + b*du.
+c On the first stage a is zero and du is not read.
+c***********************************************************************
+c
+      subroutine lsrkstep2d(
+     &  ifirst0,ilast0,ifirst1,ilast1,
+     &  gcw0,gcw1,
+     &  dt, a, b,
+     &  soln_updated,
+     &  soln_increment,
+     &  rhs,
+     &  nequ)
+c***********************************************************************
+      implicit none
+include(FORTDIR/const.i)dnl
+c***********************************************************************
+c***********************************************************************
+c input arrays:
+      integer ifirst0,ilast0,ifirst1,ilast1
+      integer gcw0,gcw1
+      integer nequ
+
+      REAL    dt, a, b
+c
+c variables in 2d cell indexed
+      REAL
+     &     soln_updated(CELL2dVECG(ifirst,ilast,gcw),0:nequ-1),
+     &     soln_increment(CELL2d(ifirst,ilast,0),0:nequ-1),
+     &     rhs(CELL2dVECG(ifirst,ilast,gcw),0:nequ-1)
+c
+c***********************************************************************
+c***********************************************************************
+c
+      integer ic0,ic1,ineq
+c
+      if (a.eq.zero) then
+         do ineq=0,nequ-1
+            do ic1=ifirst1,ilast1
+               do ic0=ifirst0,ilast0
+                  soln_increment(ic0,ic1,ineq) = dt*rhs(ic0,ic1,ineq)
+                  soln_updated(ic0,ic1,ineq) =
+     &               soln_updated(ic0,ic1,ineq) +
+     &               b*soln_increment(ic0,ic1,ineq)
+               end do
+            end do
+         end do
+      else
+         do ineq=0,nequ-1
+            do ic1=ifirst1,ilast1
+               do ic0=ifirst0,ilast0
+                  soln_increment(ic0,ic1,ineq) =
+     &               a*soln_increment(ic0,ic1,ineq) +
+     &               dt*rhs(ic0,ic1,ineq)
+                  soln_updated(ic0,ic1,ineq) =
+     &               soln_updated(ic0,ic1,ineq) +
+     &               b*soln_increment(ic0,ic1,ineq)
+               end do
+            end do
+         end do
+      endif
+
       return
       end
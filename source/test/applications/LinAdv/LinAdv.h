@@ -14,6 +14,7 @@
 #include "SAMRAI/SAMRAI_config.h"
 
 #include "SAMRAI/appu/BoundaryUtilityStrategy.h"
+#include "SAMRAI/hier/BlueprintUtils.h"
 #include "SAMRAI/hier/Box.h"
 #include "SAMRAI/geom/CartesianGridGeometry.h"
 #include "SAMRAI/pdat/CellVariable.h"
@@ -370,6 +371,13 @@ public:
       conduit::Node& node,
       int domain_id,
       const std::shared_ptr<hier::Patch>& patch);
+
+   /**
+    * Register the solution with a BlueprintUtils object that publishes
+    * the hierarchy in situ.
+    */
+   void registerBlueprintFields(
+      hier::BlueprintUtils& bp_utils);
 #endif
 
    /**
@@ -287,6 +287,14 @@ public:
    }
 
 private:
+   /*
+    * Replace the given level by one with the first box of process 0
+    * split in two, and return the new level.
+    */
+   std::shared_ptr<hier::PatchLevel>
+   splitFirstBox(
+      const int level_number);
+
    const tbox::Dimension d_dim;
 
    /*
@@ -362,6 +370,31 @@ private:
 
    bool d_is_reset;
 
+   /*
+    * Whether resetRefineSchedule() creates new schedules instead of
+    * resetting the existing ones.
+    */
+   bool d_reset_by_new_schedule;
+
+   /*
+    * Whether resetRefineSchedule() rebuilds the schedules as for a
+    * regridded level.  The finest level is regridded by splitting a
+    * box; the others keep their boxes.
+    */
+   bool d_reset_by_regridded_schedule;
+
+   /*
+    * Box split by the last call to splitFirstBox(), if any on this
+    * process.
+    */
+   hier::BoxId d_split_box_id;
+
+   /*
+    * Whether every schedule of a regridded level both reused and
+    * recomputed overlaps.
+    */
+   bool d_regrid_reuse_passed;
+
    std::vector<std::shared_ptr<xfer::RefineSchedule> > d_fill_source_schedule;
    std::vector<std::shared_ptr<xfer::RefineSchedule> > d_refine_schedule;
    std::vector<std::shared_ptr<xfer::CoarsenSchedule> > d_coarsen_schedule;
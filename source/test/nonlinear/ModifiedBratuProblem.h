@@ -32,6 +32,7 @@
 #include "SAMRAI/appu/VisItDataWriter.h"
 #include "SAMRAI/solv/CellPoissonFACSolver.h"
 #include "SAMRAI/solv/KINSOLAbstractFunctions.h"
+#include "SAMRAI/solv/NewtonKrylovAbstractFunctions.h"
 #include "SAMRAI/solv/SundialsAbstractVector.h"
 #include "SAMRAI/solv/PETScAbstractVectorReal.h"
 #include "SAMRAI/solv/SNESAbstractFunctions.h"
@@ -90,6 +91,7 @@ class ModifiedBratuProblem:
    public mesh::StandardTagAndInitStrategy,
    public solv::SNESAbstractFunctions,
    public solv::KINSOLAbstractFunctions,
+   public solv::NewtonKrylovAbstractFunctions,
    public RefinePatchStrategy,
    public CoarsenPatchStrategy,
    public tbox::Serializable
@@ -291,6 +293,42 @@ public:
       Vec z);
    //@}
 
+   //@{
+   /*!
+    * @name Interface functions overloaded from
+    * NewtonKrylovAbstractFunctions.
+    */
+
+   int
+   evaluateNonlinearFunction(
+      const std::shared_ptr<solv::SAMRAIVectorReal<double> >& xcur,
+      const std::shared_ptr<solv::SAMRAIVectorReal<double> >& fcur);
+
+   int
+   evaluateJacobian(
+      const std::shared_ptr<solv::SAMRAIVectorReal<double> >& x);
+
+   /*!
+    * @brief Compute A(x)*x.
+    *
+    * The A(x) used is the one computed in evaluateBratuJacobian()
+    * and stored at d_jacobian_a_id and d_jacobian_b_id.
+    */
+   int
+   jacobianTimesVector(
+      const std::shared_ptr<solv::SAMRAIVectorReal<double> >& vector,
+      const std::shared_ptr<solv::SAMRAIVectorReal<double> >& product);
+
+   int
+   setupPreconditioner(
+      const std::shared_ptr<solv::SAMRAIVectorReal<double> >& xcur);
+
+   int
+   applyPreconditioner(
+      const std::shared_ptr<solv::SAMRAIVectorReal<double> >& r,
+      const std::shared_ptr<solv::SAMRAIVectorReal<double> >& z);
+   //@}
+
    /*!
     * @brief Set solution ghost cell values along physical boundaries.
     *
@@ -459,17 +497,6 @@ private:
       std::shared_ptr<solv::SAMRAIVectorReal<double> > x,
       std::shared_ptr<solv::SAMRAIVectorReal<double> > f);
 
-   /*!
-    * @brief Compute A(x)*x.
-    *
-    * The A(x) used is the one computed in evaluateBratuJacobian()
-    * and stored at d_jacobian_a_id and d_jacobian_b_id.
-    */
-   int
-   jacobianTimesVector(
-      std::shared_ptr<solv::SAMRAIVectorReal<double> > vector,
-      std::shared_ptr<solv::SAMRAIVectorReal<double> > product);
-
    void
    setupBratuPreconditioner(
       std::shared_ptr<solv::SAMRAIVectorReal<double> > x);
@@ -54,3 +54,15 @@ mpiInterfaceTestAllreduce(
 int
 mpiInterfaceTestParallelPrefixSum(
    int& fail_count);
+
+/*!
+ * @brief Test that NodeGroup::getNodeGroup does not return the group of
+ * a freed communicator for a new communicator.
+ *
+ * @param fail_count Increment this count by number of failures.
+ *
+ * @return number of failures found.
+ */
+int
+mpiInterfaceTestNodeGroupCache(
+   int& fail_count);